@@ -29,20 +29,30 @@ public:
       static_assert(std::is_base_of<TrackableObject, TClazz>::value, "Must be based on LLTrackableObject");
       auto *val = new TClazz(_mContext, std::forward<Args>(args)...);
       _mTrackedObjects.emplace_back(val);
+#ifdef TAILSLIDE_PROFILE_COUNTERS
+      _mAllocatedBytes += sizeof(TClazz);
+#endif
       return val;
     }
 
     char *alloc(size_t size) {
       char *val = (char *)malloc(size);
       _mMallocs.emplace_back(val);
+#ifdef TAILSLIDE_PROFILE_COUNTERS
+      _mAllocatedBytes += size;
+#endif
       return val;
     }
 
     char *copyStr(const char *old_str) {
-      char *new_str = (char *)malloc(strlen(old_str) + 1);
+      size_t size = strlen(old_str) + 1;
+      char *new_str = (char *)malloc(size);
       if (new_str) {
         strcpy(new_str, old_str);
         trackMalloc(new_str);
+#ifdef TAILSLIDE_PROFILE_COUNTERS
+        _mAllocatedBytes += size;
+#endif
       }
       return new_str;
     }
@@ -50,7 +60,13 @@ public:
     void trackMalloc(void *alloced_data) {
       _mMallocs.emplace_back(alloced_data);
     }
+
+    // Bytes handed out so far, not counting anything passed to `trackMalloc()` directly.
+    // Always 0 unless built with TAILSLIDE_PROFILE_COUNTERS.
+    size_t getAllocatedBytes() const { return _mAllocatedBytes; }
+    size_t getAllocatedObjects() const { return _mTrackedObjects.size() + _mMallocs.size(); }
 private:
+    size_t _mAllocatedBytes = 0;
     std::vector<TrackableObject *> _mTrackedObjects {};
     std::vector<void *> _mMallocs {};
     ScriptContext *_mContext = nullptr;
@@ -3,6 +3,7 @@
 #include "passes/final_pass.hh"
 #include "passes/type_checking.hh"
 #include "passes/values.hh"
+#include "profiler.hh"
 #include "visitor.hh"
 
 namespace Tailslide {
@@ -83,10 +84,31 @@ void LSLASTNode::pushChild(LSLASTNode *child) {
     _mChildrenTail->setNext(child);
     _mChildrenTail = child;
   }
+  // the parser hands us whole sibling lists at once, the tail is wherever they end.
+  while (_mChildrenTail->getNext())
+    _mChildrenTail = _mChildrenTail->getNext();
   assert (child != this);
   child->incrementSymbolReferences();
 }
 
+void LSLASTNode::insertChild(LSLASTNode *child, LSLASTNode *before) {
+  if (before == nullptr) {
+    pushChild(child);
+    return;
+  }
+  assert(before->getParent() == this && child != nullptr);
+  LSLASTNode *prev_child = before->getPrev();
+  child->_mPrev = nullptr;
+  child->_mNext = nullptr;
+  if (prev_child != nullptr)
+    prev_child->setNext(child);
+  else
+    _mChildren = child;
+  child->setNext(before);
+  child->setParent(this);
+  child->incrementSymbolReferences();
+}
+
 LSLASTNode *LSLASTNode::takeChild(int child_num) {
   LSLASTNode *child = getChild(child_num);
   if (child == nullptr)
@@ -170,9 +192,11 @@ inline void LSLASTNode::adjustSymbolReferences(bool decrement) {
     auto *id = static_cast<LSLIdentifier*>(this);
     if (auto *sym = id->getSymbol()) {
       if (decrement) {
-        sym->removeReference();
+        sym->removeUse(id);
+        if (mContext->released_symbols && sym->getSubType() != SYM_BUILTIN)
+          mContext->released_symbols->push_back(sym);
       } else {
-        sym->addReference();
+        sym->addUse(id);
       }
     }
   } else if (getNodeType() == NODE_EXPRESSION) {
@@ -183,9 +207,9 @@ inline void LSLASTNode::adjustSymbolReferences(bool decrement) {
         auto *sym = child->getSymbol();
         if (sym && sym->getSubType() != SYM_BUILTIN) {
           if (decrement) {
-            sym->removeAssignment();
+            sym->removeDef(expr);
           } else {
-            sym->addAssignment();
+            sym->addDef(expr);
           }
         }
       }
@@ -209,6 +233,9 @@ void LSLASTNode::decrementSymbolReferences() {
 }
 
 void LSLASTNode::visit(ASTVisitor *visitor) {
+#ifdef TAILSLIDE_PROFILE_COUNTERS
+  ++visitor->mNodeVisits;
+#endif
   if (!visitor->isDepthFirst()) {
     // Use the node type and node subtype retvals to cast and choose
     // a more specific version of the visitor's visit methods to call.
@@ -234,19 +261,28 @@ void LSLASTNode::visit(ASTVisitor *visitor) {
 
 
 void LSLASTNode::propagateValues(bool create_heap_values) {
-  TailslideOperationBehavior behavior(mContext->allocator, create_heap_values);
-  ConstantDeterminingVisitor visitor(&behavior, mContext->allocator);
+  if (mContext->overBudget())
+    return;
+  TailslideOperationBehavior behavior(mContext->allocator, create_heap_values, mContext->constants);
+  ConstantDeterminingVisitor visitor(&behavior, mContext->allocator, mContext->constants);
+  PassProfileScope profile_scope(mContext, "propagate_values", &visitor);
   visit(&visitor);
 }
 
 void LSLASTNode::finalPass() {
+  if (mContext->overBudget())
+    return;
   FinalPassVisitor visitor;
+  PassProfileScope profile_scope(mContext, "final_pass", &visitor);
   visit(&visitor);
 }
 
 // walk tree post-order and propagate types
 void LSLASTNode::determineTypes() {
+  if (mContext->overBudget())
+    return;
   TypeCheckVisitor visitor;
+  PassProfileScope profile_scope(mContext, "determine_types", &visitor);
   visit(&visitor);
 }
 
@@ -191,6 +191,8 @@ class LSLASTNode : public TrackableObject {
     void setNext(LSLASTNode *newnext);
     /* Set our previous sibling, and ensure it links back to us. */
     void setPrev(LSLASTNode *newprev);
+    /* insert a child before one of our existing children, or at the end if `before` is null */
+    void insertChild(LSLASTNode *child, LSLASTNode *before);
     /* remove a child from the list of nodes, shifting other children up */
     void removeChild(LSLASTNode *child);
     /* replace a node from the list of children with null, returning it */
@@ -225,6 +227,7 @@ class LSLASTNode : public TrackableObject {
 
     /// symbol functions        ///
     virtual LSLSymbol *lookupSymbol(const char *name, LSLSymbolType type );
+    virtual bool suggestSymbol(const char *name, LSLSymbolType type, int max_dist, struct NameSuggestion &best);
     void            defineSymbol(LSLSymbol *symbol );
     LSLSymbolTable *getSymbolTable() { return _mSymbolTable; }
     void setSymbolTable(LSLSymbolTable *table) {_mSymbolTable = table;}
@@ -1,6 +1,20 @@
+#include <algorithm>
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
-
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "bitstream.hh"
 #include "lslmini.hh"
 #include "logger.hh"
 #include "strings.hh"
@@ -95,9 +109,179 @@ static void init_default_values() {
   TYPE(LST_FLOATINGPOINT)->setOneValue(float_one);
 }
 
-// called once at startup, not thread-safe.
-void tailslide_init_builtins(const char *builtins_file) {
-  LSLFunctionDec *dec = nullptr;
+enum BuiltinKind : uint8_t {
+  BUILTIN_CONST = 0,
+  BUILTIN_FUNCTION = 1,
+  BUILTIN_EVENT = 2,
+};
+
+struct BuiltinParamDesc {
+  LSLIType type;
+  const char *name;
+};
+
+// Intermediate description of a builtin, shared by the text and binary image loaders
+struct BuiltinDesc {
+  BuiltinKind kind = BUILTIN_CONST;
+  // constant type or function return type
+  LSLIType type = LST_NULL;
+  const char *name = nullptr;
+  std::vector<BuiltinParamDesc> params {};
+  int32_t int_value = 0;
+  float float_values[4] {};
+  const char *str_value = nullptr;
+  // `LSLBuiltinAttr`s of a function
+  uint8_t attrs = BUILTIN_ATTR_NONE;
+  // whether the name strings will outlive the desc, or need to be copied
+  bool persistent_names = false;
+};
+
+// Every builtin symbol from every profile, so identical builtins can be shared between profiles
+static UnorderedCStrMap<LSLSymbol *> gSharedBuiltinSymbols {};
+static std::unordered_map<std::string, LSLSymbolTable *> gBuiltinsProfiles {};
+
+static const struct {
+  const char *name;
+  uint8_t attrs;
+} BUILTIN_ATTR_NAMES[] = {
+    {"pure",          BUILTIN_ATTR_PURE | BUILTIN_ATTR_DETERMINISTIC},
+    {"reads-world",   BUILTIN_ATTR_READS_WORLD},
+    {"writes-world",  BUILTIN_ATTR_WRITES_WORLD},
+    {"may-sleep",     BUILTIN_ATTR_MAY_SLEEP},
+    {"deterministic", BUILTIN_ATTR_DETERMINISTIC},
+    {nullptr,         BUILTIN_ATTR_NONE},
+};
+
+static bool str_to_builtin_attrs(const char *str, uint8_t &attrs) {
+  for (int i = 0; BUILTIN_ATTR_NAMES[i].name != nullptr; ++i) {
+    if (strcmp(BUILTIN_ATTR_NAMES[i].name, str) == 0) {
+      attrs |= BUILTIN_ATTR_NAMES[i].attrs;
+      return true;
+    }
+  }
+  return false;
+}
+
+static LSLSymbolType builtin_kind_to_symbol_type(BuiltinKind kind) {
+  switch (kind) {
+    case BUILTIN_FUNCTION: return SYM_FUNCTION;
+    case BUILTIN_EVENT: return SYM_EVENT;
+    default: return SYM_VARIABLE;
+  }
+}
+
+static bool builtin_matches_desc(LSLSymbol *sym, const BuiltinDesc &desc) {
+  if (sym->getSymbolType() != builtin_kind_to_symbol_type(desc.kind) || sym->getIType() != desc.type)
+    return false;
+
+  if (desc.kind != BUILTIN_CONST) {
+    if (sym->getBuiltinAttrs() != desc.attrs)
+      return false;
+    size_t param_idx = 0;
+    for (auto *param : *sym->getFunctionDecl()) {
+      if (param_idx >= desc.params.size())
+        return false;
+      auto &param_desc = desc.params[param_idx++];
+      if (param->getIType() != param_desc.type)
+        return false;
+      if (strcmp(((LSLIdentifier *)param)->getName(), param_desc.name) != 0)
+        return false;
+    }
+    return param_idx == desc.params.size();
+  }
+
+  LSLConstant *value = sym->getConstantValue();
+  switch (desc.type) {
+    case LST_INTEGER:
+      return ((LSLIntegerConstant *)value)->getValue() == desc.int_value;
+    case LST_FLOATINGPOINT:
+      return (float)((LSLFloatConstant *)value)->getValue() == desc.float_values[0];
+    case LST_VECTOR:
+      return *((LSLVectorConstant *)value)->getValue() == Vector3(
+          desc.float_values[0], desc.float_values[1], desc.float_values[2]
+      );
+    case LST_QUATERNION:
+      return *((LSLQuaternionConstant *)value)->getValue() == Quaternion(
+          desc.float_values[0], desc.float_values[1], desc.float_values[2], desc.float_values[3]
+      );
+    case LST_STRING:
+      return strcmp(((LSLStringConstant *)value)->getValue(), desc.str_value) == 0;
+    default:
+      return false;
+  }
+}
+
+static LSLSymbol *build_builtin_symbol(const BuiltinDesc &desc) {
+  auto persist_name = [&desc](const char *name) -> const char * {
+    return desc.persistent_names ? name : gStaticAllocator.copyStr(name);
+  };
+
+  if (desc.kind != BUILTIN_CONST) {
+    auto *dec = gStaticAllocator.newTracked<LSLFunctionDec>();
+    for (auto &param : desc.params) {
+      dec->pushChild(gStaticAllocator.newTracked<LSLIdentifier>(
+          LSLType::get(param.type), persist_name(param.name)
+      ));
+    }
+    auto *sym = gStaticAllocator.newTracked<LSLSymbol>(
+        persist_name(desc.name), LSLType::get(desc.type), builtin_kind_to_symbol_type(desc.kind), SYM_BUILTIN, dec
+    );
+    sym->setBuiltinAttrs(desc.attrs);
+    return sym;
+  }
+
+  auto *sym = gStaticAllocator.newTracked<LSLSymbol>(
+      persist_name(desc.name), LSLType::get(desc.type), SYM_VARIABLE, SYM_BUILTIN
+  );
+  LSLConstant *const_built = nullptr;
+  switch (desc.type) {
+    case LST_INTEGER:
+      const_built = gStaticAllocator.newTracked<LSLIntegerConstant>(desc.int_value);
+      break;
+    case LST_FLOATINGPOINT:
+      const_built = gStaticAllocator.newTracked<LSLFloatConstant>(desc.float_values[0]);
+      break;
+    case LST_VECTOR:
+      const_built = gStaticAllocator.newTracked<LSLVectorConstant>(
+          desc.float_values[0], desc.float_values[1], desc.float_values[2]
+      );
+      break;
+    case LST_QUATERNION:
+      const_built = gStaticAllocator.newTracked<LSLQuaternionConstant>(
+          desc.float_values[0], desc.float_values[1], desc.float_values[2], desc.float_values[3]
+      );
+      break;
+    case LST_STRING:
+      const_built = gStaticAllocator.newTracked<LSLStringConstant>(desc.str_value);
+      break;
+    default:
+      break;
+  }
+  if (const_built) {
+    const_built->markStatic();
+    sym->setConstantValue(const_built);
+  }
+  return sym;
+}
+
+// Define a builtin in `table`, re-using an identical symbol from another profile if there is one.
+static void define_builtin(LSLSymbolTable *table, const BuiltinDesc &desc) {
+  LSLSymbol *sym = nullptr;
+  auto sym_range = gSharedBuiltinSymbols.equal_range(desc.name);
+  for (auto it = sym_range.first; it != sym_range.second; ++it) {
+    if (builtin_matches_desc(it->second, desc)) {
+      sym = it->second;
+      break;
+    }
+  }
+  if (!sym) {
+    sym = build_builtin_symbol(desc);
+    gSharedBuiltinSymbols.insert(UnorderedCStrMap<LSLSymbol*>::value_type(sym->getName(), sym));
+  }
+  table->define(sym);
+}
+
+static void parse_builtins_text(LSLSymbolTable *table, const char *builtins_file) {
   FILE *fp = nullptr;
   char buf[1025];
   char original[1025];
@@ -116,8 +300,6 @@ void tailslide_init_builtins(const char *builtins_file) {
     }
   }
 
-  init_default_values();
-
   while (true) {
     if (fp) {
       if (fgets(buf, 1024, fp) == nullptr)
@@ -143,6 +325,8 @@ void tailslide_init_builtins(const char *builtins_file) {
       return;
     }
 
+    BuiltinDesc desc;
+
     if (!strcmp(ret_type, "const")) {
       ret_type = tailslide_strtok_r(nullptr, " =(),", &tokptr);
       name = tailslide_strtok_r(nullptr, " =(),", &tokptr);
@@ -162,9 +346,9 @@ void tailslide_init_builtins(const char *builtins_file) {
       } else {
         const_type = str_to_type(ret_type);
       }
-      auto *sym = gStaticAllocator.newTracked<LSLSymbol>(
-          gStaticAllocator.copyStr(name), const_type, SYM_VARIABLE, SYM_BUILTIN
-      );
+      desc.kind = BUILTIN_CONST;
+      desc.type = const_type->getIType();
+      desc.name = name;
 
       while (*value == ' ') {
         ++value;
@@ -178,6 +362,7 @@ if(sscanf(value, (fmt), __VA_ARGS__) != num) { \
    CONST_PARSE_FAIL(); \
 }; do { } while(0)
 
+      float *fv = desc.float_values;
       switch (const_type->getIType()) {
         case LST_INTEGER: {
           int const_val;
@@ -190,33 +375,19 @@ if(sscanf(value, (fmt), __VA_ARGS__) != num) { \
               const_val = const_val_hex;
             }
           }
-          auto const_built = gStaticAllocator.newTracked<LSLIntegerConstant>(const_val);
-          const_built->markStatic();
-          sym->setConstantValue(const_built);
+          desc.int_value = const_val;
           break;
         }
         case LST_FLOATINGPOINT: {
-          float const_val;
-          CONST_SSCANF(1, "%f", &const_val);
-          auto const_built = gStaticAllocator.newTracked<LSLFloatConstant>(const_val);
-          const_built->markStatic();
-          sym->setConstantValue(const_built);
+          CONST_SSCANF(1, "%f", &fv[0]);
           break;
         }
         case LST_VECTOR: {
-          float x, y, z;
-          CONST_SSCANF(3, "<%f, %f, %f>", &x, &y, &z);
-          auto const_built = gStaticAllocator.newTracked<LSLVectorConstant>(x, y, z);
-          const_built->markStatic();
-          sym->setConstantValue(const_built);
+          CONST_SSCANF(3, "<%f, %f, %f>", &fv[0], &fv[1], &fv[2]);
           break;
         }
         case LST_QUATERNION: {
-          float x, y, z, s;
-          CONST_SSCANF(4, "<%f, %f, %f, %f>", &x, &y, &z, &s);
-          auto const_built = gStaticAllocator.newTracked<LSLQuaternionConstant>(x, y, z, s);
-          const_built->markStatic();
-          sym->setConstantValue(const_built);
+          CONST_SSCANF(4, "<%f, %f, %f, %f>", &fv[0], &fv[1], &fv[2], &fv[3]);
           break;
         }
         case LST_STRING:
@@ -224,11 +395,7 @@ if(sscanf(value, (fmt), __VA_ARGS__) != num) { \
           if (value[0] != '"') {
             CONST_PARSE_FAIL();
           }
-          auto const_built = gStaticAllocator.newTracked<LSLStringConstant>(
-              parse_string(&gStaticAllocator, value)
-          );
-          const_built->markStatic();
-          sym->setConstantValue(const_built);
+          desc.str_value = parse_string(&gStaticAllocator, value);
           break;
         }
         default:
@@ -238,9 +405,16 @@ if(sscanf(value, (fmt), __VA_ARGS__) != num) { \
 #undef CONST_PARSE_FAIL
 #undef CONST_SSCANF
 
-      gBuiltinsSymbolTable.define(sym);
+    } else {
+      // attributes come after the parameter list, parse those separately.
+      char *attrs = strrchr(tokptr, ')');
+      if (attrs == nullptr) {
+        fprintf(stderr, "error parsing %s: %s\n", builtins_file, original);
+        exit(EXIT_FAILURE);
+        return;
+      }
+      *attrs++ = '\0';
 
-    } else if (!strcmp(ret_type, "event")) {
       name = tailslide_strtok_r(nullptr, " (),", &tokptr);
 
       if (name == nullptr) {
@@ -249,41 +423,342 @@ if(sscanf(value, (fmt), __VA_ARGS__) != num) { \
         return;
       }
 
-      dec = gStaticAllocator.newTracked<LSLFunctionDec>();
+      if (!strcmp(ret_type, "event")) {
+        desc.kind = BUILTIN_EVENT;
+        desc.type = LST_NULL;
+      } else {
+        desc.kind = BUILTIN_FUNCTION;
+        desc.type = str_to_type(ret_type)->getIType();
+
+        char *attr_tokptr = nullptr;
+        char *attr = tailslide_strtok_r(attrs, " \r\n", &attr_tokptr);
+        for (; attr != nullptr; attr = tailslide_strtok_r(nullptr, " \r\n", &attr_tokptr)) {
+          if (!str_to_builtin_attrs(attr, desc.attrs)) {
+            fprintf(stderr, "invalid attribute in builtins.txt: %s\n", attr);
+            exit(EXIT_FAILURE);
+          }
+        }
+        // assume the worst about anything we don't know about
+        if (desc.attrs == BUILTIN_ATTR_NONE)
+          desc.attrs = BUILTIN_ATTR_READS_WORLD | BUILTIN_ATTR_WRITES_WORLD;
+      }
+      desc.name = name;
+
       while ((ptype = tailslide_strtok_r(nullptr, " (),", &tokptr)) != nullptr) {
         if ((pname = tailslide_strtok_r(nullptr, " (),", &tokptr)) != nullptr) {
-          dec->pushChild(gStaticAllocator.newTracked<LSLIdentifier>(
-              str_to_type(ptype), gStaticAllocator.copyStr(pname))
-          );
+          desc.params.push_back({str_to_type(ptype)->getIType(), pname});
         }
       }
+    }
 
-      gBuiltinsSymbolTable.define(gStaticAllocator.newTracked<LSLSymbol>(
-          gStaticAllocator.copyStr(name), str_to_type("void"), SYM_EVENT, SYM_BUILTIN, dec
-      ));
-    } else {
-      name = tailslide_strtok_r(nullptr, " (),", &tokptr);
+    define_builtin(table, desc);
+  }
 
-      if (name == nullptr) {
-        fprintf(stderr, "error parsing %s: %s\n", builtins_file, original);
-        exit(EXIT_FAILURE);
-        return;
-      }
+  if (fp)
+    fclose(fp);
+}
 
-      dec = gStaticAllocator.newTracked<LSLFunctionDec>();
-      while ((ptype = tailslide_strtok_r(nullptr, " (),", &tokptr)) != nullptr) {
-        if ((pname = tailslide_strtok_r(nullptr, " (),", &tokptr)) != nullptr) {
-          dec->pushChild(gStaticAllocator.newTracked<LSLIdentifier>(
-              str_to_type(ptype), gStaticAllocator.copyStr(pname)
-          ));
+static void register_builtins_profile(const char *name, LSLSymbolTable *table) {
+  // Build this now so nothing needs to mutate the shared builtins table later
+  table->buildSuggestionIndex();
+  gBuiltinsProfiles[name] = table;
+}
+
+// called once at startup, not thread-safe.
+void tailslide_init_builtins(const char *builtins_file) {
+  init_default_values();
+  parse_builtins_text(&gBuiltinsSymbolTable, builtins_file);
+  register_builtins_profile("default", &gBuiltinsSymbolTable);
+}
+
+LSLSymbolTable *tailslide_add_builtins_profile(const char *name, const char *builtins_file) {
+  auto *table = gStaticAllocator.newTracked<LSLSymbolTable>(SYMTAB_BUILTINS);
+  parse_builtins_text(table, builtins_file);
+  register_builtins_profile(name, table);
+  return table;
+}
+
+LSLSymbolTable *tailslide_get_builtins_profile(const char *name) {
+  auto profile_iter = gBuiltinsProfiles.find(name);
+  if (profile_iter == gBuiltinsProfiles.end())
+    return nullptr;
+  return profile_iter->second;
+}
+
+
+/*
+ * Binary builtins images
+ *
+ * All integers are little-endian. Strings live in a NUL-terminated string pool
+ * at the end of the image so they can be referenced in-place once mapped.
+ *
+ *   header:  "TSBI", u32 version, u32 num_entries, u32 num_params, u32 strings_size
+ *   entry:   u32 name, u8 kind, u8 type, u16 num_params, u32 first_param, u32 value[4]
+ *   param:   u32 name, u8 type, u8 pad[3]
+ *   strings: char[strings_size]
+ *
+ * value[] holds an integer, float bit patterns or a string offset depending on type.
+ * For functions, value[0] holds their `LSLBuiltinAttr`s instead.
+ */
+
+static const char BUILTINS_IMAGE_MAGIC[4] = {'T', 'S', 'B', 'I'};
+static constexpr uint32_t BUILTINS_IMAGE_VERSION = 2;
+static constexpr uint32_t BUILTINS_IMAGE_HEADER_SIZE = 20;
+static constexpr uint32_t BUILTINS_IMAGE_ENTRY_SIZE = 28;
+static constexpr uint32_t BUILTINS_IMAGE_PARAM_SIZE = 8;
+
+class BuiltinsImageStrings {
+  public:
+    uint32_t intern(const char *str) {
+      auto str_iter = _mOffsets.find(str);
+      if (str_iter != _mOffsets.end())
+        return str_iter->second;
+      auto offset = (uint32_t)_mPool.size();
+      _mPool.append(str, strlen(str) + 1);
+      _mOffsets[str] = offset;
+      return offset;
+    }
+    const std::string &pool() const { return _mPool; }
+
+  private:
+    std::string _mPool {};
+    std::unordered_map<std::string, uint32_t> _mOffsets {};
+};
+
+static uint32_t float_bits(float val) {
+  uint32_t bits;
+  memcpy(&bits, &val, sizeof(bits));
+  return bits;
+}
+
+static float bits_float(uint32_t bits) {
+  float val;
+  memcpy(&val, &bits, sizeof(val));
+  return val;
+}
+
+bool tailslide_save_builtins_image(LSLSymbolTable *profile, const char *image_file) {
+  // Hash map order isn't stable, sort so the same profile always gives the same image.
+  std::vector<LSLSymbol *> symbols;
+  for (auto &sym_pair : profile->getMap())
+    symbols.push_back(sym_pair.second);
+  std::sort(symbols.begin(), symbols.end(), [](LSLSymbol *a, LSLSymbol *b) {
+    int name_cmp = strcmp(a->getName(), b->getName());
+    if (name_cmp)
+      return name_cmp < 0;
+    return a->getSymbolType() < b->getSymbolType();
+  });
+
+  BuiltinsImageStrings strings;
+  BitStream entries(ENDIAN_LITTLE);
+  BitStream params(ENDIAN_LITTLE);
+  uint32_t num_params = 0;
+
+  for (auto *sym : symbols) {
+    uint32_t value[4] {};
+    uint16_t sym_num_params = 0;
+    uint32_t first_param = num_params;
+    BuiltinKind kind = BUILTIN_CONST;
+
+    if (sym->getSymbolType() == SYM_FUNCTION || sym->getSymbolType() == SYM_EVENT) {
+      kind = (sym->getSymbolType() == SYM_EVENT) ? BUILTIN_EVENT : BUILTIN_FUNCTION;
+      value[0] = sym->getBuiltinAttrs();
+      for (auto *param : *sym->getFunctionDecl()) {
+        params << strings.intern(((LSLIdentifier *)param)->getName()) << (uint8_t)param->getIType()
+               << (uint8_t)0 << (uint8_t)0 << (uint8_t)0;
+        ++sym_num_params;
+        ++num_params;
+      }
+    } else if (LSLConstant *const_val = sym->getConstantValue()) {
+      switch (sym->getIType()) {
+        case LST_INTEGER:
+          value[0] = (uint32_t)((LSLIntegerConstant *)const_val)->getValue();
+          break;
+        case LST_FLOATINGPOINT:
+          value[0] = float_bits((float)((LSLFloatConstant *)const_val)->getValue());
+          break;
+        case LST_VECTOR: {
+          auto *vec = ((LSLVectorConstant *)const_val)->getValue();
+          value[0] = float_bits(vec->x);
+          value[1] = float_bits(vec->y);
+          value[2] = float_bits(vec->z);
+          break;
         }
+        case LST_QUATERNION: {
+          auto *quat = ((LSLQuaternionConstant *)const_val)->getValue();
+          value[0] = float_bits(quat->x);
+          value[1] = float_bits(quat->y);
+          value[2] = float_bits(quat->z);
+          value[3] = float_bits(quat->s);
+          break;
+        }
+        case LST_STRING:
+          value[0] = strings.intern(((LSLStringConstant *)const_val)->getValue());
+          break;
+        default:
+          break;
       }
+    }
 
-      gBuiltinsSymbolTable.define(gStaticAllocator.newTracked<LSLSymbol>(
-          gStaticAllocator.copyStr(name), str_to_type(ret_type), SYM_FUNCTION, SYM_BUILTIN, dec
-      ));
+    entries << strings.intern(sym->getName()) << (uint8_t)kind << (uint8_t)sym->getIType()
+            << sym_num_params << first_param << value[0] << value[1] << value[2] << value[3];
+  }
+
+  BitStream image(ENDIAN_LITTLE);
+  image.writeRawData((const uint8_t *)BUILTINS_IMAGE_MAGIC, sizeof(BUILTINS_IMAGE_MAGIC));
+  image << BUILTINS_IMAGE_VERSION << (uint32_t)symbols.size() << num_params << (uint32_t)strings.pool().size();
+  image.writeBitStream(entries);
+  image.writeBitStream(params);
+  image.writeRawData((const uint8_t *)strings.pool().data(), (uint32_t)strings.pool().size());
+
+  FILE *fp = fopen(image_file, "wb");
+  if (fp == nullptr)
+    return false;
+  bool written = fwrite(image.data(), 1, image.size(), fp) == image.size();
+  return (fclose(fp) == 0) && written;
+}
+
+// Map the image file into memory for the life of the process, symbol names point straight into it.
+static const uint8_t *map_builtins_image(const char *image_file, uint32_t &image_size) {
+#ifdef _WIN32
+  FILE *fp = fopen(image_file, "rb");
+  if (fp == nullptr)
+    return nullptr;
+  fseek(fp, 0, SEEK_END);
+  long file_size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  // offsets within the image are 32-bit
+  if (file_size <= 0 || (uint64_t)file_size > UINT32_MAX) {
+    fclose(fp);
+    return nullptr;
+  }
+  auto *data = (uint8_t *)malloc(file_size);
+  bool read_ok = data && fread(data, 1, file_size, fp) == (size_t)file_size;
+  fclose(fp);
+  if (!read_ok) {
+    free(data);
+    return nullptr;
+  }
+  image_size = (uint32_t)file_size;
+  return data;
+#else
+  int fd = open(image_file, O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+  struct stat st {};
+  // offsets within the image are 32-bit
+  if (fstat(fd, &st) != 0 || st.st_size <= 0 || (uint64_t)st.st_size > UINT32_MAX) {
+    close(fd);
+    return nullptr;
+  }
+  void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return nullptr;
+  image_size = (uint32_t)st.st_size;
+  return (const uint8_t *)data;
+#endif
+}
+
+static void unmap_builtins_image(const uint8_t *image_data, uint32_t image_size) {
+#ifdef _WIN32
+  free((void *)image_data);
+#else
+  munmap((void *)image_data, image_size);
+#endif
+}
+
+// Read every entry in the image into `descs`, false if anything about it is off.
+static bool read_builtins_image(const uint8_t *image_data, uint32_t image_size, std::vector<BuiltinDesc> &descs) {
+  BitStream image(ENDIAN_LITTLE);
+  image.assign(image_data, image_size, true);
+
+  try {
+    uint8_t magic[4];
+    uint32_t version, num_entries, num_params, strings_size;
+    for (auto &magic_byte : magic)
+      image >> magic_byte;
+    image >> version >> num_entries >> num_params >> strings_size;
+    if (memcmp(magic, BUILTINS_IMAGE_MAGIC, sizeof(magic)) != 0 || version != BUILTINS_IMAGE_VERSION)
+      return false;
+
+    const uint64_t params_start = BUILTINS_IMAGE_HEADER_SIZE + (uint64_t)num_entries * BUILTINS_IMAGE_ENTRY_SIZE;
+    const uint64_t strings_start = params_start + (uint64_t)num_params * BUILTINS_IMAGE_PARAM_SIZE;
+    if (strings_start + strings_size != image_size || (strings_size && image_data[image_size - 1] != '\0'))
+      return false;
+    const char *strings = (const char *)image_data + strings_start;
+
+    auto get_str = [&](uint32_t offset) -> const char * {
+      if (offset >= strings_size)
+        throw std::runtime_error("string offset out of range");
+      return strings + offset;
+    };
+
+    BitStream param_stream(ENDIAN_LITTLE);
+    param_stream.assign(image_data, image_size, true);
+
+    for (uint32_t i = 0; i < num_entries; ++i) {
+      uint32_t name_offset, first_param, value[4];
+      uint8_t kind, type;
+      uint16_t entry_num_params;
+      image >> name_offset >> kind >> type >> entry_num_params >> first_param
+            >> value[0] >> value[1] >> value[2] >> value[3];
+      if (kind > BUILTIN_EVENT || type >= LST_ERROR)
+        return false;
+
+      BuiltinDesc desc;
+      desc.kind = (BuiltinKind)kind;
+      desc.type = (LSLIType)type;
+      desc.name = get_str(name_offset);
+      desc.persistent_names = true;
+
+      if (desc.kind == BUILTIN_CONST) {
+        desc.int_value = (int32_t)value[0];
+        for (int j = 0; j < 4; ++j)
+          desc.float_values[j] = bits_float(value[j]);
+        if (desc.type == LST_STRING)
+          desc.str_value = get_str(value[0]);
+      } else {
+        if ((uint64_t)first_param + entry_num_params > num_params || value[0] > UINT8_MAX)
+          return false;
+        desc.attrs = (uint8_t)value[0];
+        param_stream.moveTo((uint32_t)(params_start + (uint64_t)first_param * BUILTINS_IMAGE_PARAM_SIZE));
+        for (uint16_t j = 0; j < entry_num_params; ++j) {
+          uint32_t param_name;
+          uint8_t param_type, pad;
+          param_stream >> param_name >> param_type >> pad >> pad >> pad;
+          if (param_type >= LST_ERROR)
+            return false;
+          desc.params.push_back({(LSLIType)param_type, get_str(param_name)});
+        }
+      }
+      descs.push_back(std::move(desc));
     }
+  } catch (const std::runtime_error &) {
+    return false;
   }
+  return true;
+}
+
+LSLSymbolTable *tailslide_load_builtins_image(const char *name, const char *image_file) {
+  uint32_t image_size = 0;
+  const uint8_t *image_data = map_builtins_image(image_file, image_size);
+  if (image_data == nullptr)
+    return nullptr;
+
+  // Symbols get shared with every other profile, so nothing can be defined
+  // until we know the whole image is good.
+  std::vector<BuiltinDesc> descs;
+  if (!read_builtins_image(image_data, image_size, descs)) {
+    unmap_builtins_image(image_data, image_size);
+    return nullptr;
+  }
+
+  auto *table = gStaticAllocator.newTracked<LSLSymbolTable>(SYMTAB_BUILTINS);
+  for (auto &desc : descs)
+    define_builtin(table, desc);
+  register_builtins_profile(name, table);
+  return table;
 }
 
 }
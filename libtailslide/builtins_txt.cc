@@ -4,484 +4,488 @@
 namespace Tailslide {
 const char *BUILTINS_TXT[] = {
 "// Generated by LSL2 Derived Files Generator. Database version: 0.0.20221115000; output module version: 0.0.20140731000",
-"integer llAbs( integer val )",
-"float llAcos( float val )",
-"void llAddToLandBanList( key avatar, float hours )",
-"void llAddToLandPassList( key avatar, float hours )",
-"void llAdjustSoundVolume( float volume )",
-"integer llAgentInExperience( key agent )",
-"void llAllowInventoryDrop( integer add )",
-"float llAngleBetween( rotation a, rotation b )",
-"void llApplyImpulse( vector force, integer local )",
-"void llApplyRotationalImpulse( vector force, integer local )",
-"float llAsin( float val )",
-"float llAtan2( float y, float x )",
-"void llAttachToAvatar( integer attach_point )",
-"void llAttachToAvatarTemp( integer attach_point )",
-"key llAvatarOnLinkSitTarget( integer link )",
-"key llAvatarOnSitTarget(  )",
-"rotation llAxes2Rot( vector fwd, vector left, vector up )",
-"rotation llAxisAngle2Rot( vector axis, float angle )",
-"integer llBase64ToInteger( string str )",
-"string llBase64ToString( string str )",
-"void llBreakAllLinks(  )",
-"void llBreakLink( integer linknum )",
-"list llCSV2List( string src )",
-"list llCastRay( vector start, vector end, list params )",
-"integer llCeil( float val )",
-"string llChar( integer code )",
-"void llClearCameraParams(  )",
-"void llClearExperiencePermissions( key agent )",
-"integer llClearLinkMedia( integer link, integer face )",
-"integer llClearPrimMedia( integer face )",
-"void llCloseRemoteDataChannel( key channel )",
-"float llCloud( vector offset )",
-"void llCollisionFilter( string name, key id, integer accept )",
-"void llCollisionSound( string impact_sound, float impact_volume )",
-"void llCollisionSprite( string impact_sprite )",
-"float llCos( float theta )",
-"void llCreateCharacter( list options )",
-"key llCreateKeyValue( string k, string v )",
-"void llCreateLink( key target, integer parent )",
-"key llDataSizeKeyValue(  )",
-"void llDeleteCharacter(  )",
-"key llDeleteKeyValue( string k )",
-"list llDeleteSubList( list src, integer start, integer end )",
-"string llDeleteSubString( string src, integer start, integer end )",
-"void llDetachFromAvatar(  )",
-"vector llDetectedGrab( integer number )",
-"integer llDetectedGroup( integer number )",
-"key llDetectedKey( integer number )",
-"integer llDetectedLinkNumber( integer number )",
-"string llDetectedName( integer number )",
-"key llDetectedOwner( integer number )",
-"vector llDetectedPos( integer number )",
-"rotation llDetectedRot( integer number )",
-"vector llDetectedTouchBinormal( integer number )",
-"integer llDetectedTouchFace( integer number )",
-"vector llDetectedTouchNormal( integer number )",
-"vector llDetectedTouchPos( integer number )",
-"vector llDetectedTouchST( integer number )",
-"vector llDetectedTouchUV( integer number )",
-"integer llDetectedType( integer number )",
-"vector llDetectedVel( integer number )",
-"void llDialog( key avatar, string message, list buttons, integer chat_channel )",
-"void llDie(  )",
-"string llDumpList2String( list src, string separator )",
-"integer llEdgeOfWorld( vector pos, vector dir )",
-"void llEjectFromLand( key avatar )",
-"void llEmail( string address, string subject, string message )",
-"string llEscapeURL( string url )",
-"rotation llEuler2Rot( vector v )",
-"void llEvade( key target, list options )",
-"void llExecCharacterCmd( integer cmd, list options )",
-"float llFabs( float val )",
-"void llFleeFrom( vector source, float radius, list options )",
-"integer llFloor( float val )",
-"void llForceMouselook( integer mouselook )",
-"float llFrand( float mag )",
-"key llGenerateKey(  )",
-"vector llGetAccel(  )",
-"integer llGetAgentInfo( key id )",
-"string llGetAgentLanguage( key avatar )",
-"list llGetAgentList( integer scope, list options )",
-"vector llGetAgentSize( key id )",
-"float llGetAlpha( integer face )",
-"float llGetAndResetTime(  )",
-"string llGetAnimation( key id )",
-"list llGetAnimationList( key id )",
-"string llGetAnimationOverride( string anim_state )",
-"integer llGetAttached(  )",
-"list llGetAttachedList( key agent )",
-"list llGetBoundingBox( key object )",
-"vector llGetCameraPos(  )",
-"rotation llGetCameraRot(  )",
-"vector llGetCenterOfMass(  )",
-"list llGetClosestNavPoint( vector point, list options )",
-"vector llGetColor( integer face )",
-"key llGetCreator(  )",
-"string llGetDate(  )",
-"integer llGetDayLength(  )",
-"integer llGetDayOffset(  )",
-"string llGetDisplayName( key id )",
-"float llGetEnergy(  )",
-"string llGetEnv( string name )",
-"list llGetEnvironment( vector pos, list params )",
-"list llGetExperienceDetails( key experience_id )",
-"string llGetExperienceErrorMessage( integer value )",
-"list llGetExperienceList( key agent )",
-"vector llGetForce(  )",
-"integer llGetFreeMemory(  )",
-"integer llGetFreeURLs(  )",
-"float llGetGMTclock(  )",
-"vector llGetGeometricCenter(  )",
-"string llGetHTTPHeader( key request_id, string header )",
-"string llGetInventoryAcquireTime( string item )",
-"key llGetInventoryCreator( string item )",
-"key llGetInventoryKey( string name )",
-"string llGetInventoryName( integer type, integer number )",
-"integer llGetInventoryNumber( integer type )",
-"integer llGetInventoryPermMask( string item, integer mask )",
-"integer llGetInventoryType( string name )",
-"key llGetKey(  )",
-"key llGetLandOwnerAt( vector pos )",
-"key llGetLinkKey( integer linknumber )",
-"list llGetLinkMedia( integer link, integer face, list params )",
-"string llGetLinkName( integer linknumber )",
-"integer llGetLinkNumber(  )",
-"integer llGetLinkNumberOfSides( integer link )",
-"list llGetLinkPrimitiveParams( integer linknumber, list rules )",
-"integer llGetListEntryType( list src, integer index )",
-"integer llGetListLength( list src )",
-"vector llGetLocalPos(  )",
-"rotation llGetLocalRot(  )",
-"float llGetMass(  )",
-"float llGetMassMKS(  )",
-"float llGetMaxScaleFactor(  )",
-"integer llGetMemoryLimit(  )",
-"float llGetMinScaleFactor(  )",
-"vector llGetMoonDirection(  )",
-"rotation llGetMoonRotation(  )",
-"void llGetNextEmail( string address, string subject )",
-"key llGetNotecardLine( string name, integer line )",
-"key llGetNumberOfNotecardLines( string name )",
-"integer llGetNumberOfPrims(  )",
-"integer llGetNumberOfSides(  )",
-"list llGetObjectAnimationNames(  )",
-"string llGetObjectDesc(  )",
-"list llGetObjectDetails( key id, list params )",
-"key llGetObjectLinkKey( key id, integer link )",
-"float llGetObjectMass( key id )",
-"string llGetObjectName(  )",
-"integer llGetObjectPermMask( integer mask )",
-"integer llGetObjectPrimCount( key object_id )",
-"vector llGetOmega(  )",
-"key llGetOwner(  )",
-"key llGetOwnerKey( key id )",
-"list llGetParcelDetails( vector pos, list params )",
-"integer llGetParcelFlags( vector pos )",
-"integer llGetParcelMaxPrims( vector pos, integer sim_wide )",
-"string llGetParcelMusicURL(  )",
-"integer llGetParcelPrimCount( vector pos, integer category, integer sim_wide )",
-"list llGetParcelPrimOwners( vector pos )",
-"integer llGetPermissions(  )",
-"key llGetPermissionsKey(  )",
-"list llGetPhysicsMaterial(  )",
-"vector llGetPos(  )",
-"list llGetPrimMediaParams( integer face, list params )",
-"list llGetPrimitiveParams( list params )",
-"integer llGetRegionAgentCount(  )",
-"vector llGetRegionCorner(  )",
-"integer llGetRegionDayLength(  )",
-"integer llGetRegionDayOffset(  )",
-"float llGetRegionFPS(  )",
-"integer llGetRegionFlags(  )",
-"vector llGetRegionMoonDirection(  )",
-"rotation llGetRegionMoonRotation(  )",
-"string llGetRegionName(  )",
-"vector llGetRegionSunDirection(  )",
-"rotation llGetRegionSunRotation(  )",
-"float llGetRegionTimeDilation(  )",
-"float llGetRegionTimeOfDay(  )",
-"vector llGetRootPosition(  )",
-"rotation llGetRootRotation(  )",
-"rotation llGetRot(  )",
-"integer llGetSPMaxMemory(  )",
-"vector llGetScale(  )",
-"string llGetScriptName(  )",
-"integer llGetScriptState( string name )",
-"float llGetSimStats( integer stat_type )",
-"string llGetSimulatorHostname(  )",
-"integer llGetStartParameter(  )",
-"list llGetStaticPath( vector start, vector end, float radius, list params )",
-"integer llGetStatus( integer status )",
-"string llGetSubString( string src, integer start, integer end )",
-"vector llGetSunDirection(  )",
-"rotation llGetSunRotation(  )",
-"string llGetTexture( integer face )",
-"vector llGetTextureOffset( integer face )",
-"float llGetTextureRot( integer side )",
-"vector llGetTextureScale( integer side )",
-"float llGetTime(  )",
-"float llGetTimeOfDay(  )",
-"string llGetTimestamp(  )",
-"vector llGetTorque(  )",
-"integer llGetUnixTime(  )",
-"integer llGetUsedMemory(  )",
-"string llGetUsername( key id )",
-"vector llGetVel(  )",
-"list llGetVisualParams( key id, list params )",
-"float llGetWallclock(  )",
-"void llGiveInventory( key destination, string inventory )",
-"void llGiveInventoryList( key target, string folder, list inventory )",
-"integer llGiveMoney( key destination, integer amount )",
-"void llGodLikeRezObject( key inventory, vector pos )",
-"float llGround( vector offset )",
-"vector llGroundContour( vector offset )",
-"vector llGroundNormal( vector offset )",
-"void llGroundRepel( float height, integer water, float tau )",
-"vector llGroundSlope( vector offset )",
-"key llHTTPRequest( string url, list parameters, string body )",
-"void llHTTPResponse( key request_id, integer status, string body )",
-"integer llHash( string val )",
-"string llInsertString( string dst, integer position, string src )",
-"void llInstantMessage( key user, string message )",
-"string llIntegerToBase64( integer number )",
-"list llJson2List( string json )",
-"string llJsonGetValue( string json, list specifiers )",
-"string llJsonSetValue( string json, list specifiers, string value )",
-"string llJsonValueType( string json, list specifiers )",
-"string llKey2Name( key id )",
-"key llKeyCountKeyValue(  )",
-"key llKeysKeyValue( integer start, integer count )",
-"vector llLinear2sRGB( vector color )",
-"void llLinkParticleSystem( integer linknumber, list rules )",
-"void llLinkSitTarget( integer link, vector offset, rotation rot )",
-"integer llLinksetDataAvailable(  )",
-"integer llLinksetDataCountKeys(  )",
-"integer llLinksetDataDelete( string key )",
-"integer llLinksetDataDeleteProtected( string key, string password )",
-"list llLinksetDataFindKeys( string pattern, integer start, integer count )",
-"list llLinksetDataListKeys( integer start, integer count )",
-"string llLinksetDataRead( string key )",
-"string llLinksetDataReadProtected( string key, string password )",
-"void llLinksetDataReset(  )",
-"integer llLinksetDataWrite( string key, string value )",
-"integer llLinksetDataWriteProtected( string key, string value, string password )",
-"string llList2CSV( list src )",
-"float llList2Float( list src, integer index )",
-"integer llList2Integer( list src, integer index )",
-"string llList2Json( string type, list values )",
-"key llList2Key( list src, integer index )",
-"list llList2List( list src, integer start, integer end )",
-"list llList2ListStrided( list src, integer start, integer end, integer stride )",
-"rotation llList2Rot( list src, integer index )",
-"string llList2String( list src, integer index )",
-"vector llList2Vector( list src, integer index )",
-"integer llListFindList( list src, list test )",
-"list llListInsertList( list dest, list src, integer start )",
-"list llListRandomize( list src, integer stride )",
-"list llListReplaceList( list dest, list src, integer start, integer end )",
-"list llListSort( list src, integer stride, integer ascending )",
-"float llListStatistics( integer operation, list src )",
-"integer llListen( integer channel, string name, key id, string msg )",
-"void llListenControl( integer number, integer active )",
-"void llListenRemove( integer number )",
-"void llLoadURL( key avatar, string message, string url )",
-"float llLog( float val )",
-"float llLog10( float val )",
-"void llLookAt( vector target, float strength, float damping )",
-"void llLoopSound( string sound, float volume )",
-"void llLoopSoundMaster( string sound, float volume )",
-"void llLoopSoundSlave( string sound, float volume )",
-"string llMD5String( string src, integer nonce )",
-"void llMakeExplosion( integer particles, float scale, float vel, float lifetime, float arc, string texture, vector offset )",
-"void llMakeFire( integer particles, float scale, float vel, float lifetime, float arc, string texture, vector offset )",
-"void llMakeFountain( integer particles, float scale, float vel, float lifetime, float arc, integer bounce, string texture, vector offset, float bounce_offset )",
-"void llMakeSmoke( integer particles, float scale, float vel, float lifetime, float arc, string texture, vector offset )",
-"integer llManageEstateAccess( integer action, key id )",
-"void llMapDestination( string simname, vector pos, vector look_at )",
-"void llMessageLinked( integer linknum, integer num, string str, key id )",
-"void llMinEventDelay( float delay )",
-"integer llModPow( integer a, integer b, integer c )",
-"void llModifyLand( integer action, integer brush )",
-"void llMoveToTarget( vector target, float tau )",
-"key llName2Key( string name )",
-"void llNavigateTo( vector point, list options )",
-"void llOffsetTexture( float u, float v, integer face )",
-"integer llOpenFloater( string title, string url, list params )",
-"void llOpenRemoteDataChannel(  )",
-"integer llOrd( string val, integer index )",
-"integer llOverMyLand( key id )",
-"void llOwnerSay( string msg )",
-"void llParcelMediaCommandList( list command )",
-"list llParcelMediaQuery( list query )",
-"list llParseString2List( string src, list separators, list spacers )",
-"list llParseStringKeepNulls( string src, list separators, list spacers )",
-"void llParticleSystem( list rules )",
-"void llPassCollisions( integer pass )",
-"void llPassTouches( integer pass )",
-"void llPatrolPoints( list points, list options )",
-"void llPlaySound( string sound, float volume )",
-"void llPlaySoundSlave( string sound, float volume )",
-"void llPointAt( vector pos )",
-"float llPow( float base, float exponent )",
-"void llPreloadSound( string sound )",
-"void llPursue( key target, list options )",
-"void llPushObject( key id, vector impulse, vector ang_impulse, integer local )",
-"key llReadKeyValue( string k )",
-"void llRefreshPrimURL(  )",
-"void llRegionSay( integer channel, string msg )",
-"void llRegionSayTo( key target, integer channel, string msg )",
-"void llReleaseCamera( key avatar )",
-"void llReleaseControls(  )",
-"void llReleaseURL( string url )",
-"void llRemoteDataReply( key channel, key message_id, string sdata, integer idata )",
-"void llRemoteDataSetRegion(  )",
-"void llRemoteLoadScript( key target, string name, integer running, integer start_param )",
-"void llRemoteLoadScriptPin( key target, string name, integer pin, integer running, integer start_param )",
-"void llRemoveFromLandBanList( key avatar )",
-"void llRemoveFromLandPassList( key avatar )",
-"void llRemoveInventory( string item )",
-"void llRemoveVehicleFlags( integer flags )",
-"integer llReplaceAgentEnvironment( key agent_id, float transition, string environment )",
-"integer llReplaceEnvironment( vector position, string environment, integer track_no, integer day_length, integer day_offset )",
-"key llRequestAgentData( key id, integer data )",
-"key llRequestDisplayName( key id )",
-"void llRequestExperiencePermissions( key agent, string name )",
-"key llRequestInventoryData( string name )",
-"void llRequestPermissions( key agent, integer perm )",
-"key llRequestSecureURL(  )",
-"key llRequestSimulatorData( string simulator, integer data )",
-"key llRequestURL(  )",
-"key llRequestUserKey( string name )",
-"key llRequestUsername( key id )",
-"void llResetAnimationOverride( string anim_state )",
-"void llResetLandBanList(  )",
-"void llResetLandPassList(  )",
-"void llResetOtherScript( string name )",
-"void llResetScript(  )",
-"void llResetTime(  )",
-"integer llReturnObjectsByID( list objects )",
-"integer llReturnObjectsByOwner( key owner, integer scope )",
-"void llRezAtRoot( string inventory, vector pos, vector vel, rotation rot, integer param )",
-"void llRezObject( string inventory, vector pos, vector vel, rotation rot, integer param )",
-"float llRot2Angle( rotation rot )",
-"vector llRot2Axis( rotation rot )",
-"vector llRot2Euler( rotation q )",
-"vector llRot2Fwd( rotation q )",
-"vector llRot2Left( rotation q )",
-"vector llRot2Up( rotation q )",
-"rotation llRotBetween( vector v1, vector v2 )",
-"void llRotLookAt( rotation target, float strength, float damping )",
-"integer llRotTarget( rotation rot, float error )",
-"void llRotTargetRemove( integer number )",
-"void llRotateTexture( float angle, integer face )",
-"integer llRound( float val )",
-"string llSHA1String( string src )",
-"string llSHA256String( string src )",
-"integer llSameGroup( key id )",
-"void llSay( integer channel, string msg )",
-"integer llScaleByFactor( float scaling_factor )",
-"void llScaleTexture( float u, float v, integer face )",
-"integer llScriptDanger( vector pos )",
-"void llScriptProfiler( integer flags )",
-"key llSendRemoteData( key channel, string dest, integer idata, string sdata )",
-"void llSensor( string name, key id, integer type, float range, float arc )",
-"void llSensorRemove(  )",
-"void llSensorRepeat( string name, key id, integer type, float range, float arc, float rate )",
-"integer llSetAgentEnvironment( key agent_id, float transition, list params )",
-"void llSetAlpha( float alpha, integer face )",
-"void llSetAngularVelocity( vector angular_velocity, integer local )",
-"void llSetAnimationOverride( string anim_state, string anim )",
-"void llSetBuoyancy( float buoyancy )",
-"void llSetCameraAtOffset( vector offset )",
-"void llSetCameraEyeOffset( vector offset )",
-"void llSetCameraParams( list rules )",
-"void llSetClickAction( integer action )",
-"void llSetColor( vector color, integer face )",
-"void llSetContentType( key request_id, integer content_type )",
-"void llSetDamage( float damage )",
-"integer llSetEnvironment( vector position, list params )",
-"void llSetForce( vector force, integer local )",
-"void llSetForceAndTorque( vector force, vector torque, integer local )",
-"void llSetHoverHeight( float height, integer water, float tau )",
-"void llSetInventoryPermMask( string item, integer mask, integer value )",
-"void llSetKeyframedMotion( list keyframes, list options )",
-"void llSetLinkAlpha( integer linknumber, float alpha, integer face )",
-"void llSetLinkCamera( integer link, vector eye, vector at )",
-"void llSetLinkColor( integer linknumber, vector color, integer face )",
-"integer llSetLinkMedia( integer link, integer face, list params )",
-"void llSetLinkPrimitiveParams( integer linknumber, list rules )",
-"void llSetLinkPrimitiveParamsFast( integer linknumber, list rules )",
-"void llSetLinkTexture( integer linknumber, string texture, integer face )",
-"void llSetLinkTextureAnim( integer link, integer mode, integer face, integer sizex, integer sizey, float start, float length, float rate )",
-"void llSetLocalRot( rotation rot )",
-"integer llSetMemoryLimit( integer limit )",
-"void llSetObjectDesc( string desc )",
-"void llSetObjectName( string name )",
-"void llSetObjectPermMask( integer mask, integer value )",
-"void llSetParcelMusicURL( string url )",
-"void llSetPayPrice( integer price, list quick_pay_buttons )",
-"void llSetPhysicsMaterial( integer flags, float gravity_multiplier, float restitution, float friction, float density )",
-"void llSetPos( vector pos )",
-"integer llSetPrimMediaParams( integer face, list params )",
-"void llSetPrimURL( string url )",
-"void llSetPrimitiveParams( list rules )",
-"integer llSetRegionPos( vector pos )",
-"void llSetRemoteScriptAccessPin( integer pin )",
-"void llSetRot( rotation rot )",
-"void llSetScale( vector scale )",
-"void llSetScriptState( string name, integer run )",
-"void llSetSitText( string text )",
-"void llSetSoundQueueing( integer queue )",
-"void llSetSoundRadius( float radius )",
-"void llSetStatus( integer status, integer value )",
-"void llSetText( string text, vector color, float alpha )",
-"void llSetTexture( string texture, integer face )",
-"void llSetTextureAnim( integer mode, integer face, integer sizex, integer sizey, float start, float length, float rate )",
-"void llSetTimerEvent( float sec )",
-"void llSetTorque( vector torque, integer local )",
-"void llSetTouchText( string text )",
-"void llSetVehicleFlags( integer flags )",
-"void llSetVehicleFloatParam( integer param, float value )",
-"void llSetVehicleRotationParam( integer param, rotation rot )",
-"void llSetVehicleType( integer type )",
-"void llSetVehicleVectorParam( integer param, vector vec )",
-"void llSetVelocity( vector velocity, integer local )",
-"void llShout( integer channel, string msg )",
-"float llSin( float theta )",
-"integer llSitOnLink( key agent_id, integer link )",
-"void llSitTarget( vector offset, rotation rot )",
-"void llSleep( float sec )",
-"void llSound( string sound, float volume, integer queue, integer loop )",
-"void llSoundPreload( string sound )",
-"float llSqrt( float val )",
-"void llStartAnimation( string anim )",
-"void llStartObjectAnimation( string anim )",
-"void llStopAnimation( string anim )",
-"void llStopHover(  )",
-"void llStopLookAt(  )",
-"void llStopMoveToTarget(  )",
-"void llStopObjectAnimation( string anim )",
-"void llStopPointAt(  )",
-"void llStopSound(  )",
-"integer llStringLength( string str )",
-"string llStringToBase64( string str )",
-"string llStringTrim( string src, integer trim_type )",
-"integer llSubStringIndex( string source, string pattern )",
-"void llTakeCamera( key avatar )",
-"void llTakeControls( integer controls, integer accept, integer pass_on )",
-"float llTan( float theta )",
-"integer llTarget( vector position, float range )",
-"void llTargetOmega( vector axis, float spinrate, float gain )",
-"void llTargetRemove( integer number )",
-"void llTargetedEmail( integer target, string header, string body )",
-"void llTeleportAgent( key avatar, string landmark, vector position, vector look_at )",
-"void llTeleportAgentGlobalCoords( key agent, vector global_coordinates, vector region_coordinates, vector look_at )",
-"void llTeleportAgentHome( key id )",
-"void llTextBox( key avatar, string message, integer chat_channel )",
-"string llToLower( string src )",
-"string llToUpper( string src )",
-"key llTransferLindenDollars( key destination, integer amount )",
-"void llTriggerSound( string sound, float volume )",
-"void llTriggerSoundLimited( string sound, float volume, vector top_north_east, vector bottom_south_west )",
-"void llUnSit( key id )",
-"string llUnescapeURL( string url )",
-"void llUpdateCharacter( list options )",
-"key llUpdateKeyValue( string k, string v, integer checked, string original_value )",
-"float llVecDist( vector v1, vector v2 )",
-"float llVecMag( vector v )",
-"vector llVecNorm( vector v )",
-"void llVolumeDetect( integer detect )",
-"void llWanderWithin( vector center, vector radius, list options )",
-"float llWater( vector offset )",
-"void llWhisper( integer channel, string msg )",
-"vector llWind( vector offset )",
-"string llXorBase64( string str1, string str2 )",
-"string llXorBase64Strings( string str1, string str2 )",
-"string llXorBase64StringsCorrect( string str1, string str2 )",
-"vector llsRGB2Linear( vector srgb )",
+"// Functions are followed by what calling them might do: `pure` only computes something from its arguments,",
+"// `reads-world` depends on state outside the script, `writes-world` changes something outside the script's variables,",
+"// `may-sleep` has a forced delay and `deterministic` gives the same result for the same arguments and state.",
+"// Functions without any are assumed to read and write the world.",
+"integer llAbs( integer val ) pure",
+"float llAcos( float val ) pure",
+"void llAddToLandBanList( key avatar, float hours ) reads-world writes-world may-sleep",
+"void llAddToLandPassList( key avatar, float hours ) reads-world writes-world may-sleep",
+"void llAdjustSoundVolume( float volume ) reads-world writes-world",
+"integer llAgentInExperience( key agent ) reads-world deterministic",
+"void llAllowInventoryDrop( integer add ) reads-world writes-world",
+"float llAngleBetween( rotation a, rotation b ) pure",
+"void llApplyImpulse( vector force, integer local ) reads-world writes-world",
+"void llApplyRotationalImpulse( vector force, integer local ) reads-world writes-world",
+"float llAsin( float val ) pure",
+"float llAtan2( float y, float x ) pure",
+"void llAttachToAvatar( integer attach_point ) reads-world writes-world",
+"void llAttachToAvatarTemp( integer attach_point ) reads-world writes-world",
+"key llAvatarOnLinkSitTarget( integer link ) reads-world deterministic",
+"key llAvatarOnSitTarget(  ) reads-world deterministic",
+"rotation llAxes2Rot( vector fwd, vector left, vector up ) pure",
+"rotation llAxisAngle2Rot( vector axis, float angle ) pure",
+"integer llBase64ToInteger( string str ) pure",
+"string llBase64ToString( string str ) pure",
+"void llBreakAllLinks(  ) reads-world writes-world",
+"void llBreakLink( integer linknum ) reads-world writes-world",
+"list llCSV2List( string src ) pure",
+"list llCastRay( vector start, vector end, list params ) reads-world",
+"integer llCeil( float val ) pure",
+"string llChar( integer code ) pure",
+"void llClearCameraParams(  ) reads-world writes-world",
+"void llClearExperiencePermissions( key agent ) reads-world writes-world",
+"integer llClearLinkMedia( integer link, integer face ) reads-world writes-world",
+"integer llClearPrimMedia( integer face ) reads-world writes-world may-sleep",
+"void llCloseRemoteDataChannel( key channel ) reads-world writes-world may-sleep",
+"float llCloud( vector offset ) reads-world deterministic",
+"void llCollisionFilter( string name, key id, integer accept ) reads-world writes-world",
+"void llCollisionSound( string impact_sound, float impact_volume ) reads-world writes-world",
+"void llCollisionSprite( string impact_sprite ) reads-world writes-world",
+"float llCos( float theta ) pure",
+"void llCreateCharacter( list options ) reads-world writes-world",
+"key llCreateKeyValue( string k, string v ) reads-world writes-world",
+"void llCreateLink( key target, integer parent ) reads-world writes-world may-sleep",
+"key llDataSizeKeyValue(  ) reads-world writes-world",
+"void llDeleteCharacter(  ) reads-world writes-world",
+"key llDeleteKeyValue( string k ) reads-world writes-world",
+"list llDeleteSubList( list src, integer start, integer end ) pure",
+"string llDeleteSubString( string src, integer start, integer end ) pure",
+"void llDetachFromAvatar(  ) reads-world writes-world",
+"vector llDetectedGrab( integer number ) reads-world deterministic",
+"integer llDetectedGroup( integer number ) reads-world deterministic",
+"key llDetectedKey( integer number ) reads-world deterministic",
+"integer llDetectedLinkNumber( integer number ) reads-world deterministic",
+"string llDetectedName( integer number ) reads-world deterministic",
+"key llDetectedOwner( integer number ) reads-world deterministic",
+"vector llDetectedPos( integer number ) reads-world deterministic",
+"rotation llDetectedRot( integer number ) reads-world deterministic",
+"vector llDetectedTouchBinormal( integer number ) reads-world deterministic",
+"integer llDetectedTouchFace( integer number ) reads-world deterministic",
+"vector llDetectedTouchNormal( integer number ) reads-world deterministic",
+"vector llDetectedTouchPos( integer number ) reads-world deterministic",
+"vector llDetectedTouchST( integer number ) reads-world deterministic",
+"vector llDetectedTouchUV( integer number ) reads-world deterministic",
+"integer llDetectedType( integer number ) reads-world deterministic",
+"vector llDetectedVel( integer number ) reads-world deterministic",
+"void llDialog( key avatar, string message, list buttons, integer chat_channel ) reads-world writes-world may-sleep",
+"void llDie(  ) reads-world writes-world",
+"string llDumpList2String( list src, string separator ) pure",
+"integer llEdgeOfWorld( vector pos, vector dir ) reads-world deterministic",
+"void llEjectFromLand( key avatar ) reads-world writes-world",
+"void llEmail( string address, string subject, string message ) reads-world writes-world may-sleep",
+"string llEscapeURL( string url ) pure",
+"rotation llEuler2Rot( vector v ) pure",
+"void llEvade( key target, list options ) reads-world writes-world",
+"void llExecCharacterCmd( integer cmd, list options ) reads-world writes-world",
+"float llFabs( float val ) pure",
+"void llFleeFrom( vector source, float radius, list options ) reads-world writes-world",
+"integer llFloor( float val ) pure",
+"void llForceMouselook( integer mouselook ) reads-world writes-world",
+"float llFrand( float mag ) reads-world",
+"key llGenerateKey(  ) reads-world",
+"vector llGetAccel(  ) reads-world deterministic",
+"integer llGetAgentInfo( key id ) reads-world deterministic",
+"string llGetAgentLanguage( key avatar ) reads-world deterministic",
+"list llGetAgentList( integer scope, list options ) reads-world deterministic",
+"vector llGetAgentSize( key id ) reads-world deterministic",
+"float llGetAlpha( integer face ) reads-world deterministic",
+"float llGetAndResetTime(  ) reads-world writes-world",
+"string llGetAnimation( key id ) reads-world deterministic",
+"list llGetAnimationList( key id ) reads-world deterministic",
+"string llGetAnimationOverride( string anim_state ) reads-world deterministic",
+"integer llGetAttached(  ) reads-world deterministic",
+"list llGetAttachedList( key agent ) reads-world deterministic",
+"list llGetBoundingBox( key object ) reads-world deterministic",
+"vector llGetCameraPos(  ) reads-world deterministic",
+"rotation llGetCameraRot(  ) reads-world deterministic",
+"vector llGetCenterOfMass(  ) reads-world deterministic",
+"list llGetClosestNavPoint( vector point, list options ) reads-world deterministic",
+"vector llGetColor( integer face ) reads-world deterministic",
+"key llGetCreator(  ) reads-world deterministic",
+"string llGetDate(  ) reads-world deterministic",
+"integer llGetDayLength(  ) reads-world deterministic",
+"integer llGetDayOffset(  ) reads-world deterministic",
+"string llGetDisplayName( key id ) reads-world deterministic",
+"float llGetEnergy(  ) reads-world deterministic",
+"string llGetEnv( string name ) reads-world deterministic",
+"list llGetEnvironment( vector pos, list params ) reads-world deterministic",
+"list llGetExperienceDetails( key experience_id ) reads-world deterministic",
+"string llGetExperienceErrorMessage( integer value ) reads-world deterministic",
+"list llGetExperienceList( key agent ) reads-world deterministic",
+"vector llGetForce(  ) reads-world deterministic",
+"integer llGetFreeMemory(  ) reads-world deterministic",
+"integer llGetFreeURLs(  ) reads-world deterministic",
+"float llGetGMTclock(  ) reads-world deterministic",
+"vector llGetGeometricCenter(  ) reads-world deterministic",
+"string llGetHTTPHeader( key request_id, string header ) reads-world deterministic",
+"string llGetInventoryAcquireTime( string item ) reads-world deterministic",
+"key llGetInventoryCreator( string item ) reads-world deterministic",
+"key llGetInventoryKey( string name ) reads-world deterministic",
+"string llGetInventoryName( integer type, integer number ) reads-world deterministic",
+"integer llGetInventoryNumber( integer type ) reads-world deterministic",
+"integer llGetInventoryPermMask( string item, integer mask ) reads-world deterministic",
+"integer llGetInventoryType( string name ) reads-world deterministic",
+"key llGetKey(  ) reads-world deterministic",
+"key llGetLandOwnerAt( vector pos ) reads-world deterministic",
+"key llGetLinkKey( integer linknumber ) reads-world deterministic",
+"list llGetLinkMedia( integer link, integer face, list params ) reads-world deterministic",
+"string llGetLinkName( integer linknumber ) reads-world deterministic",
+"integer llGetLinkNumber(  ) reads-world deterministic",
+"integer llGetLinkNumberOfSides( integer link ) reads-world deterministic",
+"list llGetLinkPrimitiveParams( integer linknumber, list rules ) reads-world deterministic",
+"integer llGetListEntryType( list src, integer index ) pure",
+"integer llGetListLength( list src ) pure",
+"vector llGetLocalPos(  ) reads-world deterministic",
+"rotation llGetLocalRot(  ) reads-world deterministic",
+"float llGetMass(  ) reads-world deterministic",
+"float llGetMassMKS(  ) reads-world deterministic",
+"float llGetMaxScaleFactor(  ) reads-world deterministic",
+"integer llGetMemoryLimit(  ) reads-world deterministic",
+"float llGetMinScaleFactor(  ) reads-world deterministic",
+"vector llGetMoonDirection(  ) reads-world deterministic",
+"rotation llGetMoonRotation(  ) reads-world deterministic",
+"void llGetNextEmail( string address, string subject ) reads-world writes-world",
+"key llGetNotecardLine( string name, integer line ) reads-world writes-world may-sleep",
+"key llGetNumberOfNotecardLines( string name ) reads-world writes-world may-sleep",
+"integer llGetNumberOfPrims(  ) reads-world deterministic",
+"integer llGetNumberOfSides(  ) reads-world deterministic",
+"list llGetObjectAnimationNames(  ) reads-world deterministic",
+"string llGetObjectDesc(  ) reads-world deterministic",
+"list llGetObjectDetails( key id, list params ) reads-world deterministic",
+"key llGetObjectLinkKey( key id, integer link ) reads-world deterministic",
+"float llGetObjectMass( key id ) reads-world deterministic",
+"string llGetObjectName(  ) reads-world deterministic",
+"integer llGetObjectPermMask( integer mask ) reads-world deterministic",
+"integer llGetObjectPrimCount( key object_id ) reads-world deterministic",
+"vector llGetOmega(  ) reads-world deterministic",
+"key llGetOwner(  ) reads-world deterministic",
+"key llGetOwnerKey( key id ) reads-world deterministic",
+"list llGetParcelDetails( vector pos, list params ) reads-world deterministic",
+"integer llGetParcelFlags( vector pos ) reads-world deterministic",
+"integer llGetParcelMaxPrims( vector pos, integer sim_wide ) reads-world deterministic",
+"string llGetParcelMusicURL(  ) reads-world deterministic",
+"integer llGetParcelPrimCount( vector pos, integer category, integer sim_wide ) reads-world deterministic",
+"list llGetParcelPrimOwners( vector pos ) reads-world may-sleep deterministic",
+"integer llGetPermissions(  ) reads-world deterministic",
+"key llGetPermissionsKey(  ) reads-world deterministic",
+"list llGetPhysicsMaterial(  ) reads-world deterministic",
+"vector llGetPos(  ) reads-world deterministic",
+"list llGetPrimMediaParams( integer face, list params ) reads-world may-sleep deterministic",
+"list llGetPrimitiveParams( list params ) reads-world deterministic",
+"integer llGetRegionAgentCount(  ) reads-world deterministic",
+"vector llGetRegionCorner(  ) reads-world deterministic",
+"integer llGetRegionDayLength(  ) reads-world deterministic",
+"integer llGetRegionDayOffset(  ) reads-world deterministic",
+"float llGetRegionFPS(  ) reads-world deterministic",
+"integer llGetRegionFlags(  ) reads-world deterministic",
+"vector llGetRegionMoonDirection(  ) reads-world deterministic",
+"rotation llGetRegionMoonRotation(  ) reads-world deterministic",
+"string llGetRegionName(  ) reads-world deterministic",
+"vector llGetRegionSunDirection(  ) reads-world deterministic",
+"rotation llGetRegionSunRotation(  ) reads-world deterministic",
+"float llGetRegionTimeDilation(  ) reads-world deterministic",
+"float llGetRegionTimeOfDay(  ) reads-world deterministic",
+"vector llGetRootPosition(  ) reads-world deterministic",
+"rotation llGetRootRotation(  ) reads-world deterministic",
+"rotation llGetRot(  ) reads-world deterministic",
+"integer llGetSPMaxMemory(  ) reads-world deterministic",
+"vector llGetScale(  ) reads-world deterministic",
+"string llGetScriptName(  ) reads-world deterministic",
+"integer llGetScriptState( string name ) reads-world deterministic",
+"float llGetSimStats( integer stat_type ) reads-world deterministic",
+"string llGetSimulatorHostname(  ) reads-world deterministic",
+"integer llGetStartParameter(  ) reads-world deterministic",
+"list llGetStaticPath( vector start, vector end, float radius, list params ) reads-world deterministic",
+"integer llGetStatus( integer status ) reads-world deterministic",
+"string llGetSubString( string src, integer start, integer end ) pure",
+"vector llGetSunDirection(  ) reads-world deterministic",
+"rotation llGetSunRotation(  ) reads-world deterministic",
+"string llGetTexture( integer face ) reads-world deterministic",
+"vector llGetTextureOffset( integer face ) reads-world deterministic",
+"float llGetTextureRot( integer side ) reads-world deterministic",
+"vector llGetTextureScale( integer side ) reads-world deterministic",
+"float llGetTime(  ) reads-world deterministic",
+"float llGetTimeOfDay(  ) reads-world deterministic",
+"string llGetTimestamp(  ) reads-world deterministic",
+"vector llGetTorque(  ) reads-world deterministic",
+"integer llGetUnixTime(  ) reads-world deterministic",
+"integer llGetUsedMemory(  ) reads-world deterministic",
+"string llGetUsername( key id ) reads-world deterministic",
+"vector llGetVel(  ) reads-world deterministic",
+"list llGetVisualParams( key id, list params ) reads-world deterministic",
+"float llGetWallclock(  ) reads-world deterministic",
+"void llGiveInventory( key destination, string inventory ) reads-world writes-world",
+"void llGiveInventoryList( key target, string folder, list inventory ) reads-world writes-world may-sleep",
+"integer llGiveMoney( key destination, integer amount ) reads-world writes-world",
+"void llGodLikeRezObject( key inventory, vector pos ) reads-world writes-world",
+"float llGround( vector offset ) reads-world deterministic",
+"vector llGroundContour( vector offset ) reads-world deterministic",
+"vector llGroundNormal( vector offset ) reads-world deterministic",
+"void llGroundRepel( float height, integer water, float tau ) reads-world writes-world",
+"vector llGroundSlope( vector offset ) reads-world deterministic",
+"key llHTTPRequest( string url, list parameters, string body ) reads-world writes-world",
+"void llHTTPResponse( key request_id, integer status, string body ) reads-world writes-world",
+"integer llHash( string val ) pure",
+"string llInsertString( string dst, integer position, string src ) pure",
+"void llInstantMessage( key user, string message ) reads-world writes-world may-sleep",
+"string llIntegerToBase64( integer number ) pure",
+"list llJson2List( string json ) pure",
+"string llJsonGetValue( string json, list specifiers ) pure",
+"string llJsonSetValue( string json, list specifiers, string value ) pure",
+"string llJsonValueType( string json, list specifiers ) pure",
+"string llKey2Name( key id ) reads-world deterministic",
+"key llKeyCountKeyValue(  ) reads-world writes-world",
+"key llKeysKeyValue( integer start, integer count ) reads-world writes-world",
+"vector llLinear2sRGB( vector color ) pure",
+"void llLinkParticleSystem( integer linknumber, list rules ) reads-world writes-world",
+"void llLinkSitTarget( integer link, vector offset, rotation rot ) reads-world writes-world",
+"integer llLinksetDataAvailable(  ) reads-world deterministic",
+"integer llLinksetDataCountKeys(  ) reads-world deterministic",
+"integer llLinksetDataDelete( string key ) reads-world writes-world",
+"integer llLinksetDataDeleteProtected( string key, string password ) reads-world writes-world",
+"list llLinksetDataFindKeys( string pattern, integer start, integer count ) reads-world deterministic",
+"list llLinksetDataListKeys( integer start, integer count ) reads-world deterministic",
+"string llLinksetDataRead( string key ) reads-world deterministic",
+"string llLinksetDataReadProtected( string key, string password ) reads-world deterministic",
+"void llLinksetDataReset(  ) reads-world writes-world",
+"integer llLinksetDataWrite( string key, string value ) reads-world writes-world",
+"integer llLinksetDataWriteProtected( string key, string value, string password ) reads-world writes-world",
+"string llList2CSV( list src ) pure",
+"float llList2Float( list src, integer index ) pure",
+"integer llList2Integer( list src, integer index ) pure",
+"string llList2Json( string type, list values ) pure",
+"key llList2Key( list src, integer index ) pure",
+"list llList2List( list src, integer start, integer end ) pure",
+"list llList2ListStrided( list src, integer start, integer end, integer stride ) pure",
+"rotation llList2Rot( list src, integer index ) pure",
+"string llList2String( list src, integer index ) pure",
+"vector llList2Vector( list src, integer index ) pure",
+"integer llListFindList( list src, list test ) pure",
+"list llListInsertList( list dest, list src, integer start ) pure",
+"list llListRandomize( list src, integer stride ) reads-world",
+"list llListReplaceList( list dest, list src, integer start, integer end ) pure",
+"list llListSort( list src, integer stride, integer ascending ) pure",
+"float llListStatistics( integer operation, list src ) pure",
+"integer llListen( integer channel, string name, key id, string msg ) reads-world writes-world",
+"void llListenControl( integer number, integer active ) reads-world writes-world",
+"void llListenRemove( integer number ) reads-world writes-world",
+"void llLoadURL( key avatar, string message, string url ) reads-world writes-world may-sleep",
+"float llLog( float val ) pure",
+"float llLog10( float val ) pure",
+"void llLookAt( vector target, float strength, float damping ) reads-world writes-world",
+"void llLoopSound( string sound, float volume ) reads-world writes-world",
+"void llLoopSoundMaster( string sound, float volume ) reads-world writes-world",
+"void llLoopSoundSlave( string sound, float volume ) reads-world writes-world",
+"string llMD5String( string src, integer nonce ) pure",
+"void llMakeExplosion( integer particles, float scale, float vel, float lifetime, float arc, string texture, vector offset ) reads-world writes-world may-sleep",
+"void llMakeFire( integer particles, float scale, float vel, float lifetime, float arc, string texture, vector offset ) reads-world writes-world may-sleep",
+"void llMakeFountain( integer particles, float scale, float vel, float lifetime, float arc, integer bounce, string texture, vector offset, float bounce_offset ) reads-world writes-world may-sleep",
+"void llMakeSmoke( integer particles, float scale, float vel, float lifetime, float arc, string texture, vector offset ) reads-world writes-world may-sleep",
+"integer llManageEstateAccess( integer action, key id ) reads-world writes-world",
+"void llMapDestination( string simname, vector pos, vector look_at ) reads-world writes-world may-sleep",
+"void llMessageLinked( integer linknum, integer num, string str, key id ) reads-world writes-world",
+"void llMinEventDelay( float delay ) reads-world writes-world",
+"integer llModPow( integer a, integer b, integer c ) may-sleep deterministic",
+"void llModifyLand( integer action, integer brush ) reads-world writes-world",
+"void llMoveToTarget( vector target, float tau ) reads-world writes-world",
+"key llName2Key( string name ) reads-world deterministic",
+"void llNavigateTo( vector point, list options ) reads-world writes-world",
+"void llOffsetTexture( float u, float v, integer face ) reads-world writes-world may-sleep",
+"integer llOpenFloater( string title, string url, list params ) reads-world writes-world",
+"void llOpenRemoteDataChannel(  ) reads-world writes-world may-sleep",
+"integer llOrd( string val, integer index ) pure",
+"integer llOverMyLand( key id ) reads-world deterministic",
+"void llOwnerSay( string msg ) reads-world writes-world",
+"void llParcelMediaCommandList( list command ) reads-world writes-world may-sleep",
+"list llParcelMediaQuery( list query ) reads-world writes-world may-sleep",
+"list llParseString2List( string src, list separators, list spacers ) pure",
+"list llParseStringKeepNulls( string src, list separators, list spacers ) pure",
+"void llParticleSystem( list rules ) reads-world writes-world",
+"void llPassCollisions( integer pass ) reads-world writes-world",
+"void llPassTouches( integer pass ) reads-world writes-world",
+"void llPatrolPoints( list points, list options ) reads-world writes-world",
+"void llPlaySound( string sound, float volume ) reads-world writes-world",
+"void llPlaySoundSlave( string sound, float volume ) reads-world writes-world",
+"void llPointAt( vector pos ) reads-world writes-world",
+"float llPow( float base, float exponent ) pure",
+"void llPreloadSound( string sound ) reads-world writes-world may-sleep",
+"void llPursue( key target, list options ) reads-world writes-world",
+"void llPushObject( key id, vector impulse, vector ang_impulse, integer local ) reads-world writes-world",
+"key llReadKeyValue( string k ) reads-world writes-world",
+"void llRefreshPrimURL(  ) reads-world writes-world may-sleep",
+"void llRegionSay( integer channel, string msg ) reads-world writes-world",
+"void llRegionSayTo( key target, integer channel, string msg ) reads-world writes-world",
+"void llReleaseCamera( key avatar ) reads-world writes-world",
+"void llReleaseControls(  ) reads-world writes-world",
+"void llReleaseURL( string url ) reads-world writes-world",
+"void llRemoteDataReply( key channel, key message_id, string sdata, integer idata ) reads-world writes-world may-sleep",
+"void llRemoteDataSetRegion(  ) reads-world writes-world",
+"void llRemoteLoadScript( key target, string name, integer running, integer start_param ) reads-world writes-world may-sleep",
+"void llRemoteLoadScriptPin( key target, string name, integer pin, integer running, integer start_param ) reads-world writes-world may-sleep",
+"void llRemoveFromLandBanList( key avatar ) reads-world writes-world may-sleep",
+"void llRemoveFromLandPassList( key avatar ) reads-world writes-world may-sleep",
+"void llRemoveInventory( string item ) reads-world writes-world",
+"void llRemoveVehicleFlags( integer flags ) reads-world writes-world",
+"integer llReplaceAgentEnvironment( key agent_id, float transition, string environment ) reads-world writes-world",
+"integer llReplaceEnvironment( vector position, string environment, integer track_no, integer day_length, integer day_offset ) reads-world writes-world",
+"key llRequestAgentData( key id, integer data ) reads-world writes-world may-sleep",
+"key llRequestDisplayName( key id ) reads-world writes-world",
+"void llRequestExperiencePermissions( key agent, string name ) reads-world writes-world",
+"key llRequestInventoryData( string name ) reads-world writes-world may-sleep",
+"void llRequestPermissions( key agent, integer perm ) reads-world writes-world",
+"key llRequestSecureURL(  ) reads-world writes-world",
+"key llRequestSimulatorData( string simulator, integer data ) reads-world writes-world may-sleep",
+"key llRequestURL(  ) reads-world writes-world",
+"key llRequestUserKey( string name ) reads-world writes-world",
+"key llRequestUsername( key id ) reads-world writes-world",
+"void llResetAnimationOverride( string anim_state ) reads-world writes-world",
+"void llResetLandBanList(  ) reads-world writes-world may-sleep",
+"void llResetLandPassList(  ) reads-world writes-world may-sleep",
+"void llResetOtherScript( string name ) reads-world writes-world",
+"void llResetScript(  ) reads-world writes-world",
+"void llResetTime(  ) reads-world writes-world",
+"integer llReturnObjectsByID( list objects ) reads-world writes-world",
+"integer llReturnObjectsByOwner( key owner, integer scope ) reads-world writes-world",
+"void llRezAtRoot( string inventory, vector pos, vector vel, rotation rot, integer param ) reads-world writes-world may-sleep",
+"void llRezObject( string inventory, vector pos, vector vel, rotation rot, integer param ) reads-world writes-world may-sleep",
+"float llRot2Angle( rotation rot ) pure",
+"vector llRot2Axis( rotation rot ) pure",
+"vector llRot2Euler( rotation q ) pure",
+"vector llRot2Fwd( rotation q ) pure",
+"vector llRot2Left( rotation q ) pure",
+"vector llRot2Up( rotation q ) pure",
+"rotation llRotBetween( vector v1, vector v2 ) pure",
+"void llRotLookAt( rotation target, float strength, float damping ) reads-world writes-world",
+"integer llRotTarget( rotation rot, float error ) reads-world writes-world",
+"void llRotTargetRemove( integer number ) reads-world writes-world",
+"void llRotateTexture( float angle, integer face ) reads-world writes-world may-sleep",
+"integer llRound( float val ) pure",
+"string llSHA1String( string src ) pure",
+"string llSHA256String( string src ) pure",
+"integer llSameGroup( key id ) reads-world deterministic",
+"void llSay( integer channel, string msg ) reads-world writes-world",
+"integer llScaleByFactor( float scaling_factor ) reads-world writes-world",
+"void llScaleTexture( float u, float v, integer face ) reads-world writes-world may-sleep",
+"integer llScriptDanger( vector pos ) reads-world deterministic",
+"void llScriptProfiler( integer flags ) reads-world writes-world",
+"key llSendRemoteData( key channel, string dest, integer idata, string sdata ) reads-world writes-world may-sleep",
+"void llSensor( string name, key id, integer type, float range, float arc ) reads-world writes-world",
+"void llSensorRemove(  ) reads-world writes-world",
+"void llSensorRepeat( string name, key id, integer type, float range, float arc, float rate ) reads-world writes-world",
+"integer llSetAgentEnvironment( key agent_id, float transition, list params ) reads-world writes-world",
+"void llSetAlpha( float alpha, integer face ) reads-world writes-world",
+"void llSetAngularVelocity( vector angular_velocity, integer local ) reads-world writes-world",
+"void llSetAnimationOverride( string anim_state, string anim ) reads-world writes-world",
+"void llSetBuoyancy( float buoyancy ) reads-world writes-world",
+"void llSetCameraAtOffset( vector offset ) reads-world writes-world",
+"void llSetCameraEyeOffset( vector offset ) reads-world writes-world",
+"void llSetCameraParams( list rules ) reads-world writes-world",
+"void llSetClickAction( integer action ) reads-world writes-world",
+"void llSetColor( vector color, integer face ) reads-world writes-world",
+"void llSetContentType( key request_id, integer content_type ) reads-world writes-world",
+"void llSetDamage( float damage ) reads-world writes-world",
+"integer llSetEnvironment( vector position, list params ) reads-world writes-world",
+"void llSetForce( vector force, integer local ) reads-world writes-world",
+"void llSetForceAndTorque( vector force, vector torque, integer local ) reads-world writes-world",
+"void llSetHoverHeight( float height, integer water, float tau ) reads-world writes-world",
+"void llSetInventoryPermMask( string item, integer mask, integer value ) reads-world writes-world",
+"void llSetKeyframedMotion( list keyframes, list options ) reads-world writes-world",
+"void llSetLinkAlpha( integer linknumber, float alpha, integer face ) reads-world writes-world",
+"void llSetLinkCamera( integer link, vector eye, vector at ) reads-world writes-world",
+"void llSetLinkColor( integer linknumber, vector color, integer face ) reads-world writes-world",
+"integer llSetLinkMedia( integer link, integer face, list params ) reads-world writes-world",
+"void llSetLinkPrimitiveParams( integer linknumber, list rules ) reads-world writes-world may-sleep",
+"void llSetLinkPrimitiveParamsFast( integer linknumber, list rules ) reads-world writes-world",
+"void llSetLinkTexture( integer linknumber, string texture, integer face ) reads-world writes-world may-sleep",
+"void llSetLinkTextureAnim( integer link, integer mode, integer face, integer sizex, integer sizey, float start, float length, float rate ) reads-world writes-world",
+"void llSetLocalRot( rotation rot ) reads-world writes-world may-sleep",
+"integer llSetMemoryLimit( integer limit ) reads-world writes-world",
+"void llSetObjectDesc( string desc ) reads-world writes-world",
+"void llSetObjectName( string name ) reads-world writes-world",
+"void llSetObjectPermMask( integer mask, integer value ) reads-world writes-world",
+"void llSetParcelMusicURL( string url ) reads-world writes-world may-sleep",
+"void llSetPayPrice( integer price, list quick_pay_buttons ) reads-world writes-world",
+"void llSetPhysicsMaterial( integer flags, float gravity_multiplier, float restitution, float friction, float density ) reads-world writes-world",
+"void llSetPos( vector pos ) reads-world writes-world may-sleep",
+"integer llSetPrimMediaParams( integer face, list params ) reads-world writes-world may-sleep",
+"void llSetPrimURL( string url ) reads-world writes-world may-sleep",
+"void llSetPrimitiveParams( list rules ) reads-world writes-world may-sleep",
+"integer llSetRegionPos( vector pos ) reads-world writes-world",
+"void llSetRemoteScriptAccessPin( integer pin ) reads-world writes-world may-sleep",
+"void llSetRot( rotation rot ) reads-world writes-world may-sleep",
+"void llSetScale( vector scale ) reads-world writes-world",
+"void llSetScriptState( string name, integer run ) reads-world writes-world",
+"void llSetSitText( string text ) reads-world writes-world",
+"void llSetSoundQueueing( integer queue ) reads-world writes-world",
+"void llSetSoundRadius( float radius ) reads-world writes-world",
+"void llSetStatus( integer status, integer value ) reads-world writes-world",
+"void llSetText( string text, vector color, float alpha ) reads-world writes-world",
+"void llSetTexture( string texture, integer face ) reads-world writes-world may-sleep",
+"void llSetTextureAnim( integer mode, integer face, integer sizex, integer sizey, float start, float length, float rate ) reads-world writes-world",
+"void llSetTimerEvent( float sec ) reads-world writes-world",
+"void llSetTorque( vector torque, integer local ) reads-world writes-world",
+"void llSetTouchText( string text ) reads-world writes-world",
+"void llSetVehicleFlags( integer flags ) reads-world writes-world",
+"void llSetVehicleFloatParam( integer param, float value ) reads-world writes-world",
+"void llSetVehicleRotationParam( integer param, rotation rot ) reads-world writes-world",
+"void llSetVehicleType( integer type ) reads-world writes-world",
+"void llSetVehicleVectorParam( integer param, vector vec ) reads-world writes-world",
+"void llSetVelocity( vector velocity, integer local ) reads-world writes-world",
+"void llShout( integer channel, string msg ) reads-world writes-world",
+"float llSin( float theta ) pure",
+"integer llSitOnLink( key agent_id, integer link ) reads-world writes-world",
+"void llSitTarget( vector offset, rotation rot ) reads-world writes-world",
+"void llSleep( float sec ) reads-world writes-world may-sleep",
+"void llSound( string sound, float volume, integer queue, integer loop ) reads-world writes-world",
+"void llSoundPreload( string sound ) reads-world writes-world",
+"float llSqrt( float val ) pure",
+"void llStartAnimation( string anim ) reads-world writes-world",
+"void llStartObjectAnimation( string anim ) reads-world writes-world",
+"void llStopAnimation( string anim ) reads-world writes-world",
+"void llStopHover(  ) reads-world writes-world",
+"void llStopLookAt(  ) reads-world writes-world",
+"void llStopMoveToTarget(  ) reads-world writes-world",
+"void llStopObjectAnimation( string anim ) reads-world writes-world",
+"void llStopPointAt(  ) reads-world writes-world",
+"void llStopSound(  ) reads-world writes-world",
+"integer llStringLength( string str ) pure",
+"string llStringToBase64( string str ) pure",
+"string llStringTrim( string src, integer trim_type ) pure",
+"integer llSubStringIndex( string source, string pattern ) pure",
+"void llTakeCamera( key avatar ) reads-world writes-world",
+"void llTakeControls( integer controls, integer accept, integer pass_on ) reads-world writes-world",
+"float llTan( float theta ) pure",
+"integer llTarget( vector position, float range ) reads-world writes-world",
+"void llTargetOmega( vector axis, float spinrate, float gain ) reads-world writes-world",
+"void llTargetRemove( integer number ) reads-world writes-world",
+"void llTargetedEmail( integer target, string header, string body ) reads-world writes-world",
+"void llTeleportAgent( key avatar, string landmark, vector position, vector look_at ) reads-world writes-world",
+"void llTeleportAgentGlobalCoords( key agent, vector global_coordinates, vector region_coordinates, vector look_at ) reads-world writes-world",
+"void llTeleportAgentHome( key id ) reads-world writes-world may-sleep",
+"void llTextBox( key avatar, string message, integer chat_channel ) reads-world writes-world may-sleep",
+"string llToLower( string src ) pure",
+"string llToUpper( string src ) pure",
+"key llTransferLindenDollars( key destination, integer amount ) reads-world writes-world",
+"void llTriggerSound( string sound, float volume ) reads-world writes-world",
+"void llTriggerSoundLimited( string sound, float volume, vector top_north_east, vector bottom_south_west ) reads-world writes-world",
+"void llUnSit( key id ) reads-world writes-world",
+"string llUnescapeURL( string url ) pure",
+"void llUpdateCharacter( list options ) reads-world writes-world",
+"key llUpdateKeyValue( string k, string v, integer checked, string original_value ) reads-world writes-world",
+"float llVecDist( vector v1, vector v2 ) pure",
+"float llVecMag( vector v ) pure",
+"vector llVecNorm( vector v ) pure",
+"void llVolumeDetect( integer detect ) reads-world writes-world",
+"void llWanderWithin( vector center, vector radius, list options ) reads-world writes-world",
+"float llWater( vector offset ) reads-world deterministic",
+"void llWhisper( integer channel, string msg ) reads-world writes-world",
+"vector llWind( vector offset ) reads-world deterministic",
+"string llXorBase64( string str1, string str2 ) pure",
+"string llXorBase64Strings( string str1, string str2 ) may-sleep deterministic",
+"string llXorBase64StringsCorrect( string str1, string str2 ) pure",
+"vector llsRGB2Linear( vector srgb ) pure",
 "const integer ACTIVE = 0x2",
 "const integer AGENT = 0x1",
 "const integer AGENT_ALWAYS_RUN = 0x1000",
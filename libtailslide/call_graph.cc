@@ -0,0 +1,153 @@
+#include <algorithm>
+
+#include "call_graph.hh"
+
+namespace Tailslide {
+
+static const std::vector<LSLSymbol *> NO_CALLEES {};
+
+void CallGraph::clear() {
+  _mNodes.clear();
+  _mNodeIndices.clear();
+  _mRootCallees.clear();
+  _mSCCs.clear();
+}
+
+CallGraph::FunctionNode &CallGraph::getNode(LSLSymbol *func) {
+  auto node_iter = _mNodeIndices.find(func);
+  if (node_iter != _mNodeIndices.end())
+    return _mNodes[node_iter->second];
+  _mNodeIndices[func] = (uint32_t)_mNodes.size();
+  _mNodes.push_back({func});
+  return _mNodes.back();
+}
+
+const CallGraph::FunctionNode *CallGraph::findNode(LSLSymbol *func) const {
+  auto node_iter = _mNodeIndices.find(func);
+  if (node_iter == _mNodeIndices.end())
+    return nullptr;
+  return &_mNodes[node_iter->second];
+}
+
+void CallGraph::addFunction(LSLSymbol *func) {
+  getNode(func);
+}
+
+void CallGraph::addCall(LSLSymbol *caller, LSLSymbol *callee) {
+  getNode(callee);
+  if (!caller) {
+    _mRootCallees.push_back(callee);
+    return;
+  }
+  auto &caller_node = getNode(caller);
+  if (caller == callee)
+    caller_node.self_call = true;
+  caller_node.callees.push_back(callee);
+}
+
+void CallGraph::finalize() {
+  // we only care about which functions get called, not how many times.
+  for (auto &node : _mNodes) {
+    std::sort(node.callees.begin(), node.callees.end());
+    node.callees.erase(std::unique(node.callees.begin(), node.callees.end()), node.callees.end());
+  }
+
+  // everything called from an event handler and everything they call is reachable
+  std::vector<uint32_t> worklist;
+  for (auto *callee : _mRootCallees)
+    worklist.push_back(_mNodeIndices[callee]);
+  while (!worklist.empty()) {
+    auto &node = _mNodes[worklist.back()];
+    worklist.pop_back();
+    if (node.reachable)
+      continue;
+    node.reachable = true;
+    for (auto *callee : node.callees)
+      worklist.push_back(_mNodeIndices[callee]);
+  }
+
+  computeSCCs();
+}
+
+// Iterative Tarjan's, scripts can have deep enough call chains that recursing would be silly.
+void CallGraph::computeSCCs() {
+  _mSCCs.clear();
+  const auto num_nodes = (uint32_t)_mNodes.size();
+  constexpr uint32_t UNVISITED = UINT32_MAX;
+  std::vector<uint32_t> index(num_nodes, UNVISITED);
+  std::vector<uint32_t> low_link(num_nodes, 0);
+  std::vector<bool> on_stack(num_nodes, false);
+  std::vector<uint32_t> scc_stack;
+  // (node, next callee to look at)
+  std::vector<std::pair<uint32_t, size_t>> call_stack;
+  uint32_t next_index = 0;
+
+  for (uint32_t root = 0; root < num_nodes; ++root) {
+    if (index[root] != UNVISITED)
+      continue;
+    call_stack.emplace_back(root, 0);
+    while (!call_stack.empty()) {
+      auto &frame = call_stack.back();
+      uint32_t node_idx = frame.first;
+      if (frame.second == 0 && index[node_idx] == UNVISITED) {
+        index[node_idx] = low_link[node_idx] = next_index++;
+        scc_stack.push_back(node_idx);
+        on_stack[node_idx] = true;
+      }
+
+      auto &callees = _mNodes[node_idx].callees;
+      if (frame.second < callees.size()) {
+        uint32_t callee_idx = _mNodeIndices[callees[frame.second++]];
+        if (index[callee_idx] == UNVISITED) {
+          call_stack.emplace_back(callee_idx, 0);
+        } else if (on_stack[callee_idx]) {
+          low_link[node_idx] = std::min(low_link[node_idx], index[callee_idx]);
+        }
+        continue;
+      }
+
+      // done with all callees, pop the SCC if this is its root
+      if (low_link[node_idx] == index[node_idx]) {
+        auto scc_index = (int)_mSCCs.size();
+        _mSCCs.emplace_back();
+        uint32_t member_idx;
+        do {
+          member_idx = scc_stack.back();
+          scc_stack.pop_back();
+          on_stack[member_idx] = false;
+          _mNodes[member_idx].scc_index = scc_index;
+          _mSCCs.back().push_back(_mNodes[member_idx].symbol);
+        } while (member_idx != node_idx);
+      }
+      call_stack.pop_back();
+      if (!call_stack.empty()) {
+        uint32_t caller_idx = call_stack.back().first;
+        low_link[caller_idx] = std::min(low_link[caller_idx], low_link[node_idx]);
+      }
+    }
+  }
+}
+
+bool CallGraph::isReachable(LSLSymbol *func) const {
+  auto *node = findNode(func);
+  return !node || node->reachable;
+}
+
+bool CallGraph::isRecursive(LSLSymbol *func) const {
+  auto *node = findNode(func);
+  if (!node || node->scc_index < 0)
+    return false;
+  return node->self_call || _mSCCs[node->scc_index].size() > 1;
+}
+
+int CallGraph::getSCCIndex(LSLSymbol *func) const {
+  auto *node = findNode(func);
+  return node ? node->scc_index : -1;
+}
+
+const std::vector<LSLSymbol *> &CallGraph::getCallees(LSLSymbol *func) const {
+  auto *node = findNode(func);
+  return node ? node->callees : NO_CALLEES;
+}
+
+}
@@ -0,0 +1,53 @@
+#ifndef TAILSLIDE_CALL_GRAPH_HH
+#define TAILSLIDE_CALL_GRAPH_HH
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "symtab.hh"
+
+namespace Tailslide {
+
+/// Calls between user-defined functions, built alongside reference data.
+/// Event handlers are the roots, anything not reachable from one can never run.
+class CallGraph {
+  public:
+    void clear();
+    void addFunction(LSLSymbol *func);
+    /// `caller` is nullptr for calls made from event handlers
+    void addCall(LSLSymbol *caller, LSLSymbol *callee);
+    /// Compute SCCs and reachability, must be called after all calls are added
+    void finalize();
+
+    /// Functions the graph doesn't know about are assumed reachable
+    bool isReachable(LSLSymbol *func) const;
+    /// Whether the function can end up calling itself, directly or otherwise
+    bool isRecursive(LSLSymbol *func) const;
+    /// Functions sharing an SCC index are mutually recursive, -1 if unknown
+    int getSCCIndex(LSLSymbol *func) const;
+    const std::vector<LSLSymbol *> &getCallees(LSLSymbol *func) const;
+    /// SCCs in reverse topological order, callees come before their callers
+    const std::vector<std::vector<LSLSymbol *>> &getSCCs() const { return _mSCCs; }
+
+  private:
+    struct FunctionNode {
+      LSLSymbol *symbol;
+      std::vector<LSLSymbol *> callees;
+      int scc_index = -1;
+      bool reachable = false;
+      bool self_call = false;
+    };
+    const FunctionNode *findNode(LSLSymbol *func) const;
+    FunctionNode &getNode(LSLSymbol *func);
+    void computeSCCs();
+
+    std::vector<FunctionNode> _mNodes {};
+    std::unordered_map<LSLSymbol *, uint32_t> _mNodeIndices {};
+    std::vector<LSLSymbol *> _mRootCallees {};
+    std::vector<std::vector<LSLSymbol *>> _mSCCs {};
+};
+
+}
+
+#endif
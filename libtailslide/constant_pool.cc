@@ -0,0 +1,152 @@
+#include <cstring>
+
+#include "constant_pool.hh"
+
+namespace Tailslide {
+
+template<typename T>
+static uint32_t float_bits(T value) {
+  static_assert(sizeof(T) == sizeof(uint32_t));
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+ConstantPool::ConstantPool(ScriptAllocator *allocator) : _mAllocator(allocator) {
+  // The default values are the ones that get folded the most,
+  // and they're already static so they can be shared as-is.
+  for (auto itype : {LST_INTEGER, LST_FLOATINGPOINT, LST_STRING, LST_KEY, LST_VECTOR, LST_QUATERNION}) {
+    seed(TYPE(itype)->getDefaultValue());
+    seed(TYPE(itype)->getOneValue());
+  }
+}
+
+void ConstantPool::seed(LSLConstant *cv) {
+  // only there once the builtins have been initialized
+  if (!cv)
+    return;
+  assert(cv->isStatic());
+  switch (cv->getIType()) {
+    case LST_INTEGER:
+      _mIntegers.emplace(((LSLIntegerConstant *) cv)->getValue(), (LSLIntegerConstant *) cv);
+      break;
+    case LST_FLOATINGPOINT: {
+      double value = ((LSLFloatConstant *) cv)->getValue();
+      uint64_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      _mFloats.emplace(bits, (LSLFloatConstant *) cv);
+      break;
+    }
+    case LST_STRING:
+      _mStrings.emplace(((LSLStringConstant *) cv)->getValue(), (LSLStringConstant *) cv);
+      break;
+    case LST_KEY:
+      _mKeys.emplace(((LSLKeyConstant *) cv)->getValue(), (LSLKeyConstant *) cv);
+      break;
+    case LST_VECTOR: {
+      auto *v = ((LSLVectorConstant *) cv)->getValue();
+      _mVectors.emplace(std::array<uint32_t, 3> {
+          float_bits(v->x), float_bits(v->y), float_bits(v->z)
+      }, (LSLVectorConstant *) cv);
+      break;
+    }
+    case LST_QUATERNION: {
+      auto *q = ((LSLQuaternionConstant *) cv)->getValue();
+      _mQuaternions.emplace(std::array<uint32_t, 4> {
+          float_bits(q->x), float_bits(q->y), float_bits(q->z), float_bits(q->s)
+      }, (LSLQuaternionConstant *) cv);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+LSLIntegerConstant *ConstantPool::getInteger(S32 value) {
+  auto &cv = _mIntegers[value];
+  if (!cv) {
+    cv = _mAllocator->newTracked<LSLIntegerConstant>(value);
+    cv->markStatic();
+  }
+  return cv;
+}
+
+LSLFloatConstant *ConstantPool::getFloat(double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  auto &cv = _mFloats[bits];
+  if (!cv) {
+    cv = _mAllocator->newTracked<LSLFloatConstant>(value);
+    cv->markStatic();
+  }
+  return cv;
+}
+
+LSLStringConstant *ConstantPool::getString(const char *value) {
+  auto str_iter = _mStrings.find(value);
+  if (str_iter != _mStrings.end())
+    return str_iter->second;
+  auto *cv = _mAllocator->newTracked<LSLStringConstant>(_mAllocator->copyStr(value));
+  cv->markStatic();
+  // keyed on the constant's own copy of the string so the key lives as long as it does
+  _mStrings.emplace(cv->getValue(), cv);
+  return cv;
+}
+
+LSLKeyConstant *ConstantPool::getKey(const char *value) {
+  auto key_iter = _mKeys.find(value);
+  if (key_iter != _mKeys.end())
+    return key_iter->second;
+  auto *cv = _mAllocator->newTracked<LSLKeyConstant>(_mAllocator->copyStr(value));
+  cv->markStatic();
+  _mKeys.emplace(cv->getValue(), cv);
+  return cv;
+}
+
+LSLVectorConstant *ConstantPool::getVector(F32 x, F32 y, F32 z) {
+  auto &cv = _mVectors[{float_bits(x), float_bits(y), float_bits(z)}];
+  if (!cv) {
+    cv = _mAllocator->newTracked<LSLVectorConstant>(x, y, z);
+    cv->markStatic();
+  }
+  return cv;
+}
+
+LSLQuaternionConstant *ConstantPool::getQuaternion(F32 x, F32 y, F32 z, F32 s) {
+  auto &cv = _mQuaternions[{float_bits(x), float_bits(y), float_bits(z), float_bits(s)}];
+  if (!cv) {
+    cv = _mAllocator->newTracked<LSLQuaternionConstant>(x, y, z, s);
+    cv->markStatic();
+  }
+  return cv;
+}
+
+LSLConstant *ConstantPool::intern(LSLConstant *cv) {
+  switch (cv->getIType()) {
+    case LST_INTEGER:
+      return getInteger(((LSLIntegerConstant *) cv)->getValue());
+    case LST_FLOATINGPOINT:
+      return getFloat(((LSLFloatConstant *) cv)->getValue());
+    case LST_STRING:
+      return getString(((LSLStringConstant *) cv)->getValue());
+    case LST_KEY:
+      return getKey(((LSLKeyConstant *) cv)->getValue());
+    case LST_VECTOR: {
+      auto *v = ((LSLVectorConstant *) cv)->getValue();
+      return getVector(v->x, v->y, v->z);
+    }
+    case LST_QUATERNION: {
+      auto *q = ((LSLQuaternionConstant *) cv)->getValue();
+      return getQuaternion(q->x, q->y, q->z, q->s);
+    }
+    default:
+      return cv;
+  }
+}
+
+size_t ConstantPool::size() const {
+  return _mIntegers.size() + _mFloats.size() + _mStrings.size() + _mKeys.size()
+      + _mVectors.size() + _mQuaternions.size();
+}
+
+}
@@ -0,0 +1,49 @@
+#ifndef TAILSLIDE_CONSTANT_POOL_HH
+#define TAILSLIDE_CONSTANT_POOL_HH
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+
+#include "lslmini.hh"
+#include "unordered_cstr_map.hh"
+
+namespace Tailslide {
+
+/// Hash-consed constant values for a single script, so folding the same value over
+/// and over again doesn't allocate a new constant every time. Identical means identical
+/// down to the bit pattern of any floats, so `0.0` and `-0.0` are separate entries.
+/// Pooled constants are static, anything that puts one in the tree has to put in a copy,
+/// like `LSLConstantExpression` already does. Lists aren't pooled.
+class ConstantPool {
+  public:
+    explicit ConstantPool(ScriptAllocator *allocator);
+
+    LSLIntegerConstant *getInteger(S32 value);
+    LSLFloatConstant *getFloat(double value);
+    /// `value` gets copied if it isn't in the pool yet, so temporaries are fine.
+    LSLStringConstant *getString(const char *value);
+    LSLKeyConstant *getKey(const char *value);
+    LSLVectorConstant *getVector(F32 x, F32 y, F32 z);
+    LSLQuaternionConstant *getQuaternion(F32 x, F32 y, F32 z, F32 s);
+    /// The pooled constant with the same value as `cv`, or `cv` itself if it's a list
+    LSLConstant *intern(LSLConstant *cv);
+
+    size_t size() const;
+
+  protected:
+    void seed(LSLConstant *cv);
+
+    ScriptAllocator *_mAllocator;
+    std::unordered_map<S32, LSLIntegerConstant *> _mIntegers {};
+    std::unordered_map<uint64_t, LSLFloatConstant *> _mFloats {};
+    std::unordered_map<const char *, LSLStringConstant *, CStrHash<const char *>, CStrEqualTo<const char *>> _mStrings {};
+    std::unordered_map<const char *, LSLKeyConstant *, CStrHash<const char *>, CStrEqualTo<const char *>> _mKeys {};
+    std::map<std::array<uint32_t, 3>, LSLVectorConstant *> _mVectors {};
+    std::map<std::array<uint32_t, 4>, LSLQuaternionConstant *> _mQuaternions {};
+};
+
+}
+
+#endif //TAILSLIDE_CONSTANT_POOL_HH
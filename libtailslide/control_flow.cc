@@ -0,0 +1,215 @@
+#include <algorithm>
+
+#include "control_flow.hh"
+#include "lslmini.hh"
+
+namespace Tailslide {
+
+bool jump_always_taken(LSLStatement *jump_stmt) {
+  auto *sym = jump_stmt->getSymbol();
+  // the label's declaration and this jump
+  return sym && sym->getLabelDecl() && sym->getReferences() == 2;
+}
+
+void ControlFlowGraph::clear() {
+  _mBlocks.clear();
+  _mLabelBlocks.clear();
+  _mReversePostOrder.clear();
+  _mReachable.clear();
+  _mCurrent = ENTRY_BLOCK;
+}
+
+void ControlFlowGraph::build(LSLASTNode *func) {
+  assert(func->getNodeType() == NODE_GLOBAL_FUNCTION || func->getNodeType() == NODE_EVENT_HANDLER);
+  clear();
+  newBlock();
+  newBlock();
+  _mCurrent = ENTRY_BLOCK;
+  // functions and event handlers both keep their body in the third child
+  auto *body = func->getChild(2);
+  if (body && body->getNodeType() == NODE_STATEMENT)
+    buildStatement((LSLStatement *) body);
+  // falling off the end
+  addEdge(_mCurrent, EXIT_BLOCK);
+  computeOrder();
+}
+
+uint32_t ControlFlowGraph::newBlock() {
+  _mBlocks.emplace_back();
+  return (uint32_t)(_mBlocks.size() - 1);
+}
+
+void ControlFlowGraph::addEdge(uint32_t from, uint32_t to) {
+  _mBlocks[from].succs.push_back(to);
+  _mBlocks[to].preds.push_back(from);
+}
+
+uint32_t ControlFlowGraph::getLabelBlock(LSLLabel *label) {
+  // jumps may come before the label they target, whoever gets there first makes the block.
+  auto label_iter = _mLabelBlocks.find(label);
+  if (label_iter != _mLabelBlocks.end())
+    return label_iter->second;
+  uint32_t block = newBlock();
+  _mLabelBlocks[label] = block;
+  return block;
+}
+
+void ControlFlowGraph::buildStatement(LSLStatement *stmt) {
+  switch (stmt->getNodeSubType()) {
+    case NODE_COMPOUND_STATEMENT:
+      for (auto *child : *stmt) {
+        if (child->getNodeType() == NODE_STATEMENT)
+          buildStatement((LSLStatement *) child);
+      }
+      return;
+    case NODE_EXPRESSION_STATEMENT: {
+      if (auto *expr = ((LSLExpressionStatement *) stmt)->getExpr())
+        _mBlocks[_mCurrent].nodes.push_back(expr);
+      return;
+    }
+    case NODE_DECLARATION:
+      _mBlocks[_mCurrent].nodes.push_back(stmt);
+      return;
+    case NODE_RETURN_STATEMENT: {
+      if (auto *expr = ((LSLReturnStatement *) stmt)->getExpr())
+        _mBlocks[_mCurrent].nodes.push_back(expr);
+      addEdge(_mCurrent, EXIT_BLOCK);
+      _mCurrent = newBlock();
+      return;
+    }
+    case NODE_STATE_STATEMENT:
+      // state changes never come back to the handler or function that made them
+      addEdge(_mCurrent, EXIT_BLOCK);
+      _mCurrent = newBlock();
+      return;
+    case NODE_JUMP_STATEMENT: {
+      auto *sym = stmt->getSymbol();
+      auto *label = sym ? sym->getLabelDecl() : nullptr;
+      uint32_t jump_block = _mCurrent;
+      addEdge(jump_block, label ? getLabelBlock(label) : EXIT_BLOCK);
+      _mCurrent = newBlock();
+      // might be one of the jumps LSO leaves unpatched
+      if (label && !jump_always_taken(stmt))
+        addEdge(jump_block, _mCurrent);
+      return;
+    }
+    case NODE_LABEL: {
+      uint32_t label_block = getLabelBlock((LSLLabel *) stmt);
+      addEdge(_mCurrent, label_block);
+      _mCurrent = label_block;
+      return;
+    }
+    case NODE_IF_STATEMENT: {
+      auto *if_stmt = (LSLIfStatement *) stmt;
+      _mBlocks[_mCurrent].nodes.push_back(if_stmt->getCheckExpr());
+      uint32_t cond_block = _mCurrent;
+
+      _mCurrent = newBlock();
+      addEdge(cond_block, _mCurrent);
+      if (auto *true_branch = if_stmt->getTrueBranch())
+        buildStatement(true_branch);
+      uint32_t true_end = _mCurrent;
+
+      uint32_t false_end = cond_block;
+      if (auto *false_branch = if_stmt->getFalseBranch()) {
+        _mCurrent = newBlock();
+        addEdge(cond_block, _mCurrent);
+        buildStatement(false_branch);
+        false_end = _mCurrent;
+      }
+
+      _mCurrent = newBlock();
+      addEdge(true_end, _mCurrent);
+      addEdge(false_end, _mCurrent);
+      return;
+    }
+    case NODE_WHILE_STATEMENT: {
+      auto *while_stmt = (LSLWhileStatement *) stmt;
+      uint32_t cond_block = newBlock();
+      addEdge(_mCurrent, cond_block);
+      _mBlocks[cond_block].nodes.push_back(while_stmt->getCheckExpr());
+
+      _mCurrent = newBlock();
+      addEdge(cond_block, _mCurrent);
+      if (auto *body = while_stmt->getBody())
+        buildStatement(body);
+      addEdge(_mCurrent, cond_block);
+
+      _mCurrent = newBlock();
+      addEdge(cond_block, _mCurrent);
+      return;
+    }
+    case NODE_DO_STATEMENT: {
+      auto *do_stmt = (LSLDoStatement *) stmt;
+      uint32_t body_block = newBlock();
+      addEdge(_mCurrent, body_block);
+      _mCurrent = body_block;
+      if (auto *body = do_stmt->getBody())
+        buildStatement(body);
+
+      uint32_t cond_block = newBlock();
+      addEdge(_mCurrent, cond_block);
+      _mBlocks[cond_block].nodes.push_back(do_stmt->getCheckExpr());
+      addEdge(cond_block, body_block);
+
+      _mCurrent = newBlock();
+      addEdge(cond_block, _mCurrent);
+      return;
+    }
+    case NODE_FOR_STATEMENT: {
+      auto *for_stmt = (LSLForStatement *) stmt;
+      if (auto *init_exprs = for_stmt->getInitExprs()) {
+        for (auto *expr : *init_exprs)
+          _mBlocks[_mCurrent].nodes.push_back(expr);
+      }
+      uint32_t cond_block = newBlock();
+      addEdge(_mCurrent, cond_block);
+      _mBlocks[cond_block].nodes.push_back(for_stmt->getCheckExpr());
+
+      _mCurrent = newBlock();
+      addEdge(cond_block, _mCurrent);
+      if (auto *body = for_stmt->getBody())
+        buildStatement(body);
+
+      uint32_t incr_block = newBlock();
+      addEdge(_mCurrent, incr_block);
+      if (auto *incr_exprs = for_stmt->getIncrExprs()) {
+        for (auto *expr : *incr_exprs)
+          _mBlocks[incr_block].nodes.push_back(expr);
+      }
+      addEdge(incr_block, cond_block);
+
+      _mCurrent = newBlock();
+      addEdge(cond_block, _mCurrent);
+      return;
+    }
+    default:
+      return;
+  }
+}
+
+void ControlFlowGraph::computeOrder() {
+  _mReachable.assign(_mBlocks.size(), false);
+  _mReversePostOrder.clear();
+  // iterative DFS, (block, next successor to look at)
+  std::vector<std::pair<uint32_t, size_t>> stack;
+  stack.emplace_back(ENTRY_BLOCK, 0);
+  _mReachable[ENTRY_BLOCK] = true;
+  while (!stack.empty()) {
+    auto &frame = stack.back();
+    auto &succs = _mBlocks[frame.first].succs;
+    if (frame.second < succs.size()) {
+      uint32_t succ = succs[frame.second++];
+      if (!_mReachable[succ]) {
+        _mReachable[succ] = true;
+        stack.emplace_back(succ, 0);
+      }
+      continue;
+    }
+    _mReversePostOrder.push_back(frame.first);
+    stack.pop_back();
+  }
+  std::reverse(_mReversePostOrder.begin(), _mReversePostOrder.end());
+}
+
+}
@@ -0,0 +1,63 @@
+#ifndef TAILSLIDE_CONTROL_FLOW_HH
+#define TAILSLIDE_CONTROL_FLOW_HH
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Tailslide {
+
+class LSLASTNode;
+class LSLLabel;
+class LSLStatement;
+
+/// Whether a `jump` statement always ends up at its label. LSO only patches the last
+/// `jump` to any given label, the others jump nowhere and fall through to whatever
+/// follows them. Only a jump that's the only one to its label can be trusted.
+bool jump_always_taken(LSLStatement *jump_stmt);
+
+/// A straight-line run of code within a function or event handler body.
+/// `nodes` are whatever gets evaluated when the block runs, in order: expressions
+/// (including branch conditions and return values) and declarations. Statements
+/// themselves only show up in the graph as edges.
+struct FlowBlock {
+  std::vector<LSLASTNode *> nodes;
+  std::vector<uint32_t> succs;
+  std::vector<uint32_t> preds;
+};
+
+/// Control flow graph for a single `LSLGlobalFunction` or `LSLEventHandler`.
+/// `return` and `state` both leave through the exit block, code following them
+/// or an unconditional `jump` starts a new block with no predecessors.
+class ControlFlowGraph {
+  public:
+    static constexpr uint32_t ENTRY_BLOCK = 0;
+    static constexpr uint32_t EXIT_BLOCK = 1;
+
+    void build(LSLASTNode *func);
+    void clear();
+
+    std::vector<FlowBlock> &getBlocks() { return _mBlocks; }
+    /// Blocks reachable from the entry in reverse postorder, predecessors come
+    /// before their successors other than along back edges.
+    const std::vector<uint32_t> &getReversePostOrder() const { return _mReversePostOrder; }
+    bool isReachable(uint32_t block) const { return _mReachable[block]; }
+
+  private:
+    uint32_t newBlock();
+    void addEdge(uint32_t from, uint32_t to);
+    uint32_t getLabelBlock(LSLLabel *label);
+    void buildStatement(LSLStatement *stmt);
+    void computeOrder();
+
+    std::vector<FlowBlock> _mBlocks {};
+    std::unordered_map<LSLLabel *, uint32_t> _mLabelBlocks {};
+    std::vector<uint32_t> _mReversePostOrder {};
+    std::vector<bool> _mReachable {};
+    // the block control is currently flowing through while building
+    uint32_t _mCurrent = ENTRY_BLOCK;
+};
+
+}
+
+#endif
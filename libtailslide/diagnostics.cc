@@ -0,0 +1,134 @@
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "diagnostics.hh"
+
+namespace Tailslide {
+
+void append_json_string(std::string &out, const char *str) {
+  static const char HEX_CHARS[] = "0123456789abcdef";
+  out += '"';
+  for (const char *pos = str; *pos; ++pos) {
+    auto c = (unsigned char)*pos;
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if (c < 0x20) {
+          out += "\\u00";
+          out += HEX_CHARS[c >> 4];
+          out += HEX_CHARS[c & 0xF];
+        } else {
+          out += (char)c;
+        }
+    }
+  }
+  out += '"';
+}
+
+static const char *get_level_name(LogLevel level) {
+  switch (level) {
+    case LOG_ERROR:
+    case LOG_INTERNAL_ERROR:
+      return "error";
+    case LOG_WARN:
+      return "warning";
+    default:
+      return "note";
+  }
+}
+
+void FDDiagnosticSink::writeOut(const std::string &data) {
+  const char *pos = data.c_str();
+  size_t remaining = data.size();
+  while (remaining) {
+#ifdef _WIN32
+    auto written = _write(_mFD, pos, (unsigned int)remaining);
+#else
+    auto written = write(_mFD, pos, remaining);
+#endif
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      // nowhere sensible to report this, just drop the diagnostic.
+      return;
+    }
+    pos += written;
+    remaining -= written;
+  }
+}
+
+void JSONLinesDiagnosticSink::emit(LogMessage *message) {
+  auto *loc = message->getLoc();
+  _mLine.clear();
+  _mLine += "{\"file\":";
+  append_json_string(_mLine, _mURI.c_str());
+  _mLine += ",\"level\":\"";
+  _mLine += get_level_name(message->getType());
+  _mLine += "\",\"code\":";
+  _mLine += std::to_string((int)message->getError());
+  _mLine += ",\"line\":" + std::to_string(loc->first_line);
+  _mLine += ",\"column\":" + std::to_string(loc->first_column);
+  _mLine += ",\"end_line\":" + std::to_string(loc->last_line);
+  _mLine += ",\"end_column\":" + std::to_string(loc->last_column);
+  _mLine += ",\"message\":";
+  append_json_string(_mLine, message->getMessage().c_str());
+  _mLine += "}\n";
+  writeOut(_mLine);
+}
+
+void SARIFDiagnosticSink::begin() {
+  _mFirstResult = true;
+  writeOut(
+      "{\"version\":\"2.1.0\","
+      "\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\","
+      "\"runs\":[{\"tool\":{\"driver\":{\"name\":\"tailslide\","
+      "\"informationUri\":\"https://github.com/secondlife/tailslide\"}},"
+      "\"results\":[\n"
+  );
+}
+
+void SARIFDiagnosticSink::emit(LogMessage *message) {
+  auto *loc = message->getLoc();
+  _mLine.clear();
+  if (!_mFirstResult)
+    _mLine += ",\n";
+  _mFirstResult = false;
+
+  _mLine += "{\"level\":\"";
+  _mLine += get_level_name(message->getType());
+  _mLine += "\"";
+  if (message->getError() != 0)
+    _mLine += ",\"ruleId\":\"E" + std::to_string((int)message->getError()) + "\"";
+  _mLine += ",\"message\":{\"text\":";
+  append_json_string(_mLine, message->getMessage().c_str());
+  _mLine += "},\"locations\":[{\"physicalLocation\":{\"artifactLocation\":{\"uri\":";
+  append_json_string(_mLine, _mURI.c_str());
+  _mLine += "}";
+  // SARIF lines and columns are 1-based, synthetic nodes have no real location
+  if (loc->first_line > 0 && loc->first_column > 0) {
+    _mLine += ",\"region\":{\"startLine\":" + std::to_string(loc->first_line);
+    _mLine += ",\"startColumn\":" + std::to_string(loc->first_column);
+    if (loc->last_line >= loc->first_line && loc->last_column > 0) {
+      _mLine += ",\"endLine\":" + std::to_string(loc->last_line);
+      _mLine += ",\"endColumn\":" + std::to_string(loc->last_column);
+    }
+    _mLine += "}";
+  }
+  _mLine += "}}]}";
+  writeOut(_mLine);
+}
+
+void SARIFDiagnosticSink::end() {
+  writeOut("\n]}]}\n");
+}
+
+}
@@ -0,0 +1,58 @@
+#ifndef TAILSLIDE_DIAGNOSTICS_HH
+#define TAILSLIDE_DIAGNOSTICS_HH
+
+#include <string>
+
+#include "logger.hh"
+
+namespace Tailslide {
+
+/// Receives each diagnostic as soon as it's logged, in the order it was logged.
+/// Messages handed to a sink may not outlive the call, copy anything you need.
+class DiagnosticSink {
+  public:
+    virtual ~DiagnosticSink() = default;
+    virtual void begin() {}
+    virtual void emit(LogMessage *message) = 0;
+    virtual void end() {}
+};
+
+/// Base for sinks that write straight to a file descriptor without buffering
+/// more than the diagnostic currently being written.
+class FDDiagnosticSink : public DiagnosticSink {
+  public:
+    /// `uri` is the name of the script the diagnostics are for
+    FDDiagnosticSink(int fd, const char *uri) : _mFD(fd), _mURI(uri ? uri : "") {}
+
+  protected:
+    void writeOut(const std::string &data);
+    std::string _mLine {};
+    int _mFD;
+    std::string _mURI;
+};
+
+/// One JSON object per line, per diagnostic.
+class JSONLinesDiagnosticSink : public FDDiagnosticSink {
+  public:
+    using FDDiagnosticSink::FDDiagnosticSink;
+    void emit(LogMessage *message) override;
+};
+
+/// A SARIF 2.1.0 log with a single run, results are written as they come in.
+class SARIFDiagnosticSink : public FDDiagnosticSink {
+  public:
+    using FDDiagnosticSink::FDDiagnosticSink;
+    void begin() override;
+    void emit(LogMessage *message) override;
+    void end() override;
+
+  private:
+    bool _mFirstResult = true;
+};
+
+/// Append `str` to `out` as a quoted JSON string
+void append_json_string(std::string &out, const char *str);
+
+}
+
+#endif
@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
+#include <cstring>
+#include "diagnostics.hh"
 #include "logger.hh"
 #include "lslmini.hh"
 
@@ -29,8 +31,32 @@ struct LogMessageSort {
 
 void Logger::reset() {
   _mMessages.clear();
+  _mSorted = true;
   _mErrors = 0;
   _mWarnings = 0;
+  _mOverBudget = false;
+  _mOverWarningBudget = false;
+  _mCappedCodeCounts.clear();
+  memset(_mCodeCounters, 0, sizeof(_mCodeCounters));
+}
+
+static int get_code_counter_index(int code) {
+  if (code >= E_ERROR && code < E_LAST)
+    return code - E_ERROR;
+  if (code >= W_WARNING && code < W_LAST)
+    return (E_LAST - E_ERROR) + (code - W_WARNING);
+  return -1;
+}
+
+void Logger::countCode(int code) {
+  int idx = get_code_counter_index(code);
+  if (idx >= 0)
+    ++_mCodeCounters[idx];
+}
+
+int Logger::getCodeCount(int code) const {
+  int idx = get_code_counter_index(code);
+  return (idx >= 0) ? _mCodeCounters[idx] : 0;
 }
 
 void Logger::log(LogLevel level, YYLTYPE *yylloc, const char *fmt, ...) {
@@ -40,9 +66,88 @@ void Logger::log(LogLevel level, YYLTYPE *yylloc, const char *fmt, ...) {
   va_end(args);
 }
 
+// Parse the conversion spec following a `%`. Only the handful of specs used by
+// the error messages are understood: `%s`, `%d` and their positional `%N$` forms.
+static bool parse_log_spec(const char *&pos, int &next_arg, int &arg_idx, char &conv) {
+  const char *spec = pos;
+  int position = 0;
+  while (*spec >= '0' && *spec <= '9')
+    position = position * 10 + (*spec++ - '0');
+  if (spec != pos) {
+    if (*spec != '$' || position == 0)
+      return false;
+    arg_idx = position - 1;
+    ++spec;
+  } else {
+    arg_idx = next_arg++;
+  }
+  if (*spec != 's' && *spec != 'd')
+    return false;
+  if (arg_idx >= LOG_MAX_ARGS)
+    return false;
+  conv = *spec;
+  pos = spec + 1;
+  return true;
+}
+
+// Figure out how many arguments `fmt` takes and which of them are strings
+static bool get_log_arg_types(const char *fmt, bool (&is_string)[LOG_MAX_ARGS], int &num_args) {
+  int next_arg = 0;
+  num_args = 0;
+  for (const char *pos = fmt; *pos; ++pos) {
+    if (*pos != '%')
+      continue;
+    if (*++pos == '%')
+      continue;
+    int arg_idx;
+    char conv;
+    if (!parse_log_spec(pos, next_arg, arg_idx, conv))
+      return false;
+    is_string[arg_idx] = (conv == 's');
+    num_args = std::max(num_args, arg_idx + 1);
+    --pos;
+  }
+  return true;
+}
+
+static void format_log_message(std::string &out, const char *fmt, const LogArg *args, int num_args) {
+  int next_arg = 0;
+  for (const char *pos = fmt; *pos;) {
+    if (*pos != '%') {
+      out += *pos++;
+      continue;
+    }
+    ++pos;
+    if (*pos == '%') {
+      out += *pos++;
+      continue;
+    }
+    int arg_idx;
+    char conv;
+    if (!parse_log_spec(pos, next_arg, arg_idx, conv) || arg_idx >= num_args) {
+      out += '%';
+      continue;
+    }
+    const LogArg &arg = args[arg_idx];
+    if (arg.is_string)
+      out += arg.str_val ? arg.str_val : "(null)";
+    else
+      out += std::to_string(arg.int_val);
+  }
+}
+
+const char *Logger::internString(const char *str) {
+  if (!str)
+    return nullptr;
+  auto str_iter = _mInternedStrings.find(str);
+  if (str_iter != _mInternedStrings.end())
+    return *str_iter;
+  const char *interned = _mAllocator->copyStr(str);
+  _mInternedStrings.insert(interned);
+  return interned;
+}
+
 void Logger::error(YYLTYPE *yylloc, int error, ...) {
-  char buf[1025] = {0};
-  std::ostringstream oss;
   const char *fmt;
   LogLevel level = (error < W_WARNING) ? LOG_ERROR : LOG_WARN;
   va_list args;
@@ -54,24 +159,99 @@ void Logger::error(YYLTYPE *yylloc, int error, ...) {
     fmt = _sWarningMessages[(int) (error - W_WARNING)];
   }
 
-  // Format the actual error message
-  va_start(args, error);
-  vsnprintf(buf, sizeof(buf), fmt, args);
-  va_end(args);
-
-  oss << buf;
-
   // Update error/warning counts
   if (level == LOG_ERROR) {
     ++_mErrors;
   } else {
     ++_mWarnings;
   }
+  if (!withinBudget(level, yylloc, error))
+    return;
+  if (_mCountsOnly) {
+    countCode(error);
+    return;
+  }
 
-  std::string message = oss.str();
-  _mMessages.push_back(createMessage(level, yylloc, message, (ErrorCode) error));
-  if (_mSort)
-    std::sort(_mMessages.begin(), _mMessages.end(), LogMessageSort());
+  // Just stash the arguments, the message only gets formatted if someone wants its text.
+  bool is_string[LOG_MAX_ARGS] = {};
+  int num_args = 0;
+  va_start(args, error);
+  if (get_log_arg_types(fmt, is_string, num_args)) {
+    LogArg log_args[LOG_MAX_ARGS] {};
+    for (int i = 0; i < num_args; ++i) {
+      log_args[i].is_string = is_string[i];
+      if (is_string[i]) {
+        // no need for a copy if the message won't outlive this call
+        const char *str_val = va_arg(args, const char *);
+        log_args[i].str_val = _mRetainMessages ? internString(str_val) : str_val;
+      } else {
+        log_args[i].int_val = va_arg(args, int);
+      }
+    }
+    if (_mRetainMessages) {
+      addMessage(_mAllocator->newTracked<LogMessage>(level, yylloc, (ErrorCode) error, fmt, log_args, num_args));
+    } else {
+      LogMessage message(nullptr, level, yylloc, (ErrorCode) error, fmt, log_args, num_args);
+      addMessage(&message);
+    }
+  } else {
+    char buf[1025] = {0};
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    addMessage(level, yylloc, buf, (ErrorCode) error);
+  }
+  va_end(args);
+}
+
+void Logger::addMessage(LogLevel type, YYLTYPE *loc, const char *message, ErrorCode error) {
+  if (_mCountsOnly) {
+    countCode(error);
+    return;
+  }
+  if (_mRetainMessages) {
+    addMessage(createMessage(type, loc, message, error));
+  } else {
+    LogMessage log_message(nullptr, type, loc, message, error);
+    addMessage(&log_message);
+  }
+}
+
+bool Logger::withinBudget(LogLevel type, YYLTYPE *loc, int error) {
+  if (_mOverBudget)
+    return false;
+
+  if (type == LOG_ERROR && _mBudget.max_errors && _mErrors > _mBudget.max_errors) {
+    _mOverBudget = true;
+    ++_mErrors;
+    addMessage(LOG_ERROR, loc, _sErrorMessages[E_DIAGNOSTIC_BUDGET_EXCEEDED - E_ERROR], E_DIAGNOSTIC_BUDGET_EXCEEDED);
+    return false;
+  }
+
+  if (type == LOG_WARN && _mBudget.max_warnings && _mWarnings > _mBudget.max_warnings) {
+    // only a notice that some warnings were dropped, so not counted as one itself
+    if (!_mOverWarningBudget)
+      addMessage(LOG_WARN, loc, _sWarningMessages[W_WARNING_BUDGET_EXCEEDED - W_WARNING], W_WARNING_BUDGET_EXCEEDED);
+    _mOverWarningBudget = true;
+    return false;
+  }
+
+  if (_mBudget.default_code_cap || !_mBudget.code_caps.empty()) {
+    int cap = _mBudget.default_code_cap;
+    auto cap_iter = _mBudget.code_caps.find(error);
+    if (cap_iter != _mBudget.code_caps.end())
+      cap = cap_iter->second;
+    if (cap && ++_mCappedCodeCounts[error] > cap)
+      return false;
+  }
+  return true;
+}
+
+void Logger::addMessage(LogMessage *message) {
+  if (_mSink)
+    _mSink->emit(message);
+  if (_mRetainMessages) {
+    _mMessages.push_back(message);
+    _mSorted = false;
+  }
 }
 
 
@@ -90,7 +270,7 @@ void Logger::logv(LogLevel level, YYLTYPE *yylloc, const char *fmt, va_list args
     case LOG_DEBUG_MINOR:
     case LOG_DEBUG_SPAM:
 #ifdef DEBUG_LEVEL
-      if ( DEBUG_LEVEL < level ) return;
+      if ( DEBUG_LEVEL < level || gDebugLevel < level ) return;
 #else /* not DEBUG_LEVEL */
       return;
 #endif /* not DEBUG_LEVEL */
@@ -99,14 +279,46 @@ void Logger::logv(LogLevel level, YYLTYPE *yylloc, const char *fmt, va_list args
       break;
   }
 
+  if ((level == LOG_ERROR || level == LOG_WARN) && !withinBudget(level, yylloc, error))
+    return;
+  if (_mCountsOnly) {
+    countCode(error);
+    return;
+  }
+
   char buf[1025] = {0};
   vsnprintf(buf, sizeof(buf), fmt, args);
-  _mMessages.push_back(createMessage(level, yylloc, buf, (ErrorCode) error));
+  addMessage(level, yylloc, buf, (ErrorCode) error);
+}
+
+LogLevel gDebugLevel = LOG_INFO;
+
+void tailslide_set_debug_level(LogLevel level) {
+  gDebugLevel = level;
+}
+
+void tailslide_debug_log(LogLevel level, YYLTYPE *yylloc, const char *fmt, ...) {
+  va_list args;
+  if (yylloc)
+    fprintf(stderr, "DEBUG:: (%3d,%3d): ", yylloc->first_line, yylloc->first_column);
+  else
+    fprintf(stderr, "DEBUG:: ");
+  va_start(args, fmt);
+  vfprintf(stderr, fmt, args);
+  va_end(args);
+}
+
+void Logger::sortMessages() const {
+  if (_mSorted)
+    return;
+  // Stable so messages at the same position stay in the order they were logged
   if (_mSort)
-    std::sort(_mMessages.begin(), _mMessages.end(), LogMessageSort());
+    std::stable_sort(_mMessages.begin(), _mMessages.end(), LogMessageSort());
+  _mSorted = true;
 }
 
 void Logger::printReport() {
+  sortMessages();
   std::vector<LogMessage *>::iterator i;
   for (i = _mMessages.begin(); i != _mMessages.end(); ++i)
     fprintf(stderr, "%s\n", (*i)->toString().c_str());
@@ -123,6 +335,25 @@ LogMessage::LogMessage(ScriptContext *ctx, LogLevel type, YYLTYPE *loc, const ch
   if (loc) _mLoc = *loc;
   assert (message != nullptr);
   _mMessage = message;
+  _mFormatted = true;
+}
+
+LogMessage::LogMessage(ScriptContext *ctx, LogLevel type, YYLTYPE *loc, ErrorCode error,
+                       const char *fmt, const LogArg *args, int num_args)
+    : TrackableObject(ctx), _mLogType(type), _mLoc({}), _mErrorCode(error), _mFormat(fmt),
+      _mNumArgs(num_args) {
+  if (loc) _mLoc = *loc;
+  assert (fmt != nullptr && num_args <= LOG_MAX_ARGS);
+  for (int i = 0; i < num_args; ++i)
+    _mArgs[i] = args[i];
+}
+
+const std::string &LogMessage::getMessage() const {
+  if (!_mFormatted) {
+    format_log_message(_mMessage, _mFormat, _mArgs, _mNumArgs);
+    _mFormatted = true;
+  }
+  return _mMessage;
 }
 
 std::string LogMessage::toString() const {
@@ -160,7 +391,7 @@ std::string LogMessage::toString() const {
     oss << "[E" << _mErrorCode << "] ";
   }
 
-  oss << _mMessage;
+  oss << getMessage();
 
   return oss.str();
 }
@@ -207,7 +438,8 @@ const char *Logger::_sErrorMessages[] = {
         "May not cast %s to %s",
         "Lists may not contain nulls",
         "Stack-heap collision",
-        "Void expression used as condition"
+        "Void expression used as condition",
+        "Too many errors, giving up."
 };
 
 const char *Logger::_sWarningMessages[] = {
@@ -232,6 +464,7 @@ const char *Logger::_sWarningMessages[] = {
         "== comparison used as a statement",
         "`%s' is deprecated.",
         "`%s' is deprecated, use %s instead.",
+        "Too many warnings, not reporting any more.",
 };
 
 }
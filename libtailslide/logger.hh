@@ -1,14 +1,18 @@
 #ifndef _LOGGER_HH
 #define _LOGGER_HH 1
 
+#include <cstdarg>
 #include <cstdlib>
 #include <cstdio>
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>  // pair
 
 #include "allocator.hh"
 #include "loctype.hh"
+#include "unordered_cstr_map.hh"
 
 namespace Tailslide {
 
@@ -63,6 +67,7 @@ enum ErrorCode {
     E_NULL_IN_LIST = 10036,
     E_STACK_HEAP_COLLISION = 10037,
     E_VOID_IN_CONDITION = 10038,
+    E_DIAGNOSTIC_BUDGET_EXCEEDED = 10039,
     E_LAST,
 
 
@@ -90,6 +95,7 @@ enum ErrorCode {
     W_EQ_AS_STATEMENT = 20018,
     W_DEPRECATED = 20019,
     W_DEPRECATED_WITH_REPLACEMENT = 20020,
+    W_WARNING_BUDGET_EXCEEDED = 20021,
     W_LAST,
 };
 
@@ -98,6 +104,33 @@ enum ErrorCode {
 #define NODE_ERROR(node, ...) do {(node)->mContext->logger->error((node)->getLoc(), __VA_ARGS__);} while(0)
 #endif
 
+// Raw argument to an error message, formatted only when the text is asked for
+struct LogArg {
+  bool is_string;
+  union {
+    int int_val;
+    const char *str_val;
+  };
+};
+
+// No error or warning message takes more than this many arguments
+static constexpr int LOG_MAX_ARGS = 6;
+
+class DiagnosticSink;
+
+// Limits on how many diagnostics we'll bother recording for a script, 0 means no limit.
+// Going over max_errors logs E_DIAGNOSTIC_BUDGET_EXCEEDED and tells passes to bail.
+// Warnings can't make the output wrong, so going over max_warnings only logs
+// W_WARNING_BUDGET_EXCEEDED and drops further warnings. Going over a per-code cap
+// just drops further messages with that code.
+struct DiagnosticBudget {
+  int max_errors = 0;
+  int max_warnings = 0;
+  // cap for any code not in `code_caps`
+  int default_code_cap = 0;
+  std::unordered_map<int, int> code_caps {};
+};
+
 class Logger {
   public:
     explicit Logger(ScriptAllocator *allocator) :
@@ -109,48 +142,96 @@ class Logger {
     void printReport();
     void reset();
 
-    const std::vector<class LogMessage*> & getMessages() const { return _mMessages; };
+    // Messages are sorted on first access rather than as they're logged
+    const std::vector<class LogMessage*> & getMessages() const { sortMessages(); return _mMessages; };
     int     getErrors() const    { return _mErrors;    }
     int     getWarnings() const  { return _mWarnings;  }
     void    setShowEnd(bool v) { _mShowEnd = v; }
     void    setShowInfo(bool v){ _mShowInfo = v;}
     void    setSort(bool v)     { _mSort = v;     }
+    // Every message gets handed to the sink as it's logged, the sink isn't owned by the logger.
+    void    setSink(DiagnosticSink *sink) { _mSink = sink; }
+    // Whether to hold onto messages after they've gone to the sink, getMessages()
+    // and printReport() only know about retained messages.
+    void    setRetainMessages(bool v) { _mRetainMessages = v; }
+    void    setBudget(const DiagnosticBudget &budget) { _mBudget = budget; }
+    // Once this is set there's no point running any more passes over the script
+    bool    isOverBudget() const { return _mOverBudget; }
+    // Only keep a count of each code that gets logged, no messages get created at all
+    void    setCountsOnly(bool v)  { _mCountsOnly = v; }
+    int     getCodeCount(int code) const;
 
     // Create a LogMessage without adding it to the internal message list
     LogMessage* createMessage(LogLevel type, YYLTYPE *loc, const std::string &message, ErrorCode error);
 
   protected:
+    // string arguments may be temporaries, so messages keep an interned copy
+    const char *internString(const char *str);
+    void addMessage(LogMessage *message);
+    void addMessage(LogLevel type, YYLTYPE *loc, const char *message, ErrorCode error);
+    bool withinBudget(LogLevel type, YYLTYPE *loc, int error);
+    void countCode(int code);
+
     int     _mErrors;
     int     _mWarnings;
     bool    _mShowEnd;
     bool    _mShowInfo;
     bool    _mSort;
     ScriptAllocator *_mAllocator;
-
-    std::vector<class LogMessage*>    _mMessages;
+    DiagnosticSink *_mSink = nullptr;
+    bool _mRetainMessages = true;
+    DiagnosticBudget _mBudget {};
+    bool _mOverBudget = false;
+    bool _mOverWarningBudget = false;
+    std::unordered_map<int, int> _mCappedCodeCounts {};
+    bool _mCountsOnly = false;
+    int _mCodeCounters[(E_LAST - E_ERROR) + (W_LAST - W_WARNING)] {};
+
+    void sortMessages() const;
+    mutable bool _mSorted = true;
+    mutable std::vector<class LogMessage*>    _mMessages;
+    std::unordered_set<const char *, CStrHash<const char *>, CStrEqualTo<const char *>> _mInternedStrings {};
     static const char *_sErrorMessages[];
     static const char *_sWarningMessages[];
 };
 
-inline void DEBUG(LogLevel level, YYLTYPE *yylloc, const char *fmt, ...) {
-  va_list args;
-  va_start(args, fmt);
-  //Logger::get()->logv(level, yylloc, fmt, args);
-  va_end(args);
-}
+// Debug messages only exist in builds with DEBUG_LEVEL defined, anything more verbose
+// than DEBUG_LEVEL is compiled out. Of what's left, only messages at or below the
+// runtime debug level are printed to stderr, nothing is by default.
+extern LogLevel gDebugLevel;
+void tailslide_set_debug_level(LogLevel level);
+void tailslide_debug_log(LogLevel level, YYLTYPE *yylloc, const char *fmt, ...);
+
+#ifndef HIDE_TAILSLIDE_INTERNALS
+#ifdef DEBUG_LEVEL
+#define DEBUG(level, yylloc, ...) do { \
+    if ((level) <= DEBUG_LEVEL && (level) <= gDebugLevel) \
+      tailslide_debug_log((level), (yylloc), __VA_ARGS__); \
+  } while(0)
+#else
+// arguments are never evaluated, so they can be as expensive as they like
+#define DEBUG(level, yylloc, ...) do {} while(0)
+#endif
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 // Log message entry, for sorting
 class LogMessage: public TrackableObject {
   public:
     LogMessage( ScriptContext *ctx, LogLevel type, YYLTYPE *loc, const char *message, ErrorCode error );
+    // message text is only built from `fmt` and `args` once somebody asks for it
+    LogMessage( ScriptContext *ctx, LogLevel type, YYLTYPE *loc, ErrorCode error,
+                const char *fmt, const LogArg *args, int num_args );
 
     LogLevel    getType() { return _mLogType; }
     YYLTYPE    *getLoc()  { return &_mLoc;  }
     ErrorCode   getError() { return _mErrorCode; }
-    const std::string &getMessage() { return _mMessage; }
+    const std::string &getMessage() const;
     std::string toString() const;
 
+    int getNumArgs() const { return _mNumArgs; }
+    const LogArg &getArg(int idx) const { return _mArgs[idx]; }
+
   private:
     LogLevel            _mLogType;
 
@@ -159,8 +240,13 @@ class LogMessage: public TrackableObject {
     // be invalid when we go to sort.
     YYLTYPE             _mLoc;
 
-    std::string         _mMessage;
     ErrorCode           _mErrorCode;
+
+    const char         *_mFormat = nullptr;
+    LogArg              _mArgs[LOG_MAX_ARGS] {};
+    int                 _mNumArgs = 0;
+    mutable bool        _mFormatted = false;
+    mutable std::string _mMessage;
 };
 
 }
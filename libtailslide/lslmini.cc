@@ -6,7 +6,16 @@
 #include "lslmini.hh"
 #include "logger.hh"
 #include "ast.hh"
+#include "name_suggestions.hh"
+#include "profiler.hh"
 #include "visitor.hh"
+#include "passes/constant_propagation.hh"
+#include "passes/inliner.hh"
+#include "passes/loop_invariant_motion.hh"
+#include "passes/dead_stores.hh"
+#include "passes/copy_propagation.hh"
+#include "passes/side_effects.hh"
+#include "passes/subexpression_elimination.hh"
 #include "passes/tree_simplifier.hh"
 #include "passes/symbol_resolution.hh"
 #include "passes/globalexpr_validator.hh"
@@ -50,6 +59,21 @@ LSLSymbol *LSLScript::lookupSymbol(const char *name, LSLSymbolType sym_type) {
   return LSLASTNode::lookupSymbol(name, sym_type);
 }
 
+// Find the closest-named symbol in any scope visible from here, for "did you mean" errors.
+bool LSLASTNode::suggestSymbol(const char *name, LSLSymbolType type, int max_dist, NameSuggestion &best) {
+  bool found = false;
+  if (_mSymbolTable)
+    found = _mSymbolTable->suggest(name, type, max_dist, best);
+  if (getParent())
+    found = getParent()->suggestSymbol(name, type, max_dist, best) || found;
+  return found;
+}
+
+bool LSLScript::suggestSymbol(const char *name, LSLSymbolType sym_type, int max_dist, NameSuggestion &best) {
+  bool found = mContext->builtins->suggest(name, sym_type, max_dist, best);
+  return LSLASTNode::suggestSymbol(name, sym_type, max_dist, best) || found;
+}
+
 // Define a symbol, propagating up the tree to the nearest scope level.
 void LSLASTNode::defineSymbol(LSLSymbol *symbol) {
 
@@ -114,7 +138,10 @@ void LSLASTNode::defineSymbol(LSLSymbol *symbol) {
 
 // Define any symbols we have, and ask our children to
 void LSLASTNode::collectSymbols() {
+  if (mContext->overBudget())
+    return;
   SymbolResolutionVisitor visitor(true, mContext->allocator);
+  PassProfileScope profile_scope(mContext, "collect_symbols", &visitor);
   this->visit(&visitor);
 }
 
@@ -162,10 +189,14 @@ void LSLIdentifier::resolveSymbol(LSLSymbolType symbol_type) {
                  LSLSymbol::getTypeName(_mSymbol->getSymbolType())
       );
     } else {
-      /* Name suggestion was here */
       if (_mType != TYPE(LST_ERROR)) {
         // don't re-warn about undeclared if we already know we're broken.
-        NODE_ERROR(this, E_UNDECLARED, _mName);
+        NameSuggestion suggestion;
+        if (suggestSymbol(_mName, symbol_type, NameSuggestionIndex::maxDistanceFor(_mName), suggestion)) {
+          NODE_ERROR(this, E_UNDECLARED_WITH_SUGGESTION, _mName, suggestion.symbol->getName());
+        } else {
+          NODE_ERROR(this, E_UNDECLARED, _mName);
+        }
       }
     }
 
@@ -180,6 +211,8 @@ void LSLIdentifier::resolveSymbol(LSLSymbolType symbol_type) {
 }
 
 void LSLASTNode::checkSymbols() {
+  if (mContext->overBudget())
+    return;
   if (getSymbolTable() != nullptr)
     getSymbolTable()->checkSymbols();
 
@@ -188,8 +221,24 @@ void LSLASTNode::checkSymbols() {
 }
 
 
+// Recomputes reference and assignment counts and the call graph in a single pass,
+// keeping track of the function we're in as we go.
 class NodeReferenceUpdatingVisitor : public ASTVisitor {
   public:
+    explicit NodeReferenceUpdatingVisitor(CallGraph *call_graph) : _mCallGraph(call_graph) {}
+
+    virtual bool visit(LSLGlobalFunction *glob_func) {
+      auto *func_sym = glob_func->getSymbol();
+      if (func_sym)
+        _mCallGraph->addFunction(func_sym);
+      _mCurrentFunc = func_sym;
+      _mCurrentFuncId = glob_func->getIdentifier();
+      visitChildren(glob_func);
+      _mCurrentFunc = nullptr;
+      _mCurrentFuncId = nullptr;
+      return false;
+    }
+
     virtual bool visit(LSLExpression *expr) {
       if (operation_mutates(expr->getOperation())) {
         auto *child = (LSLLValueExpression *)expr->getChild(0);
@@ -200,47 +249,138 @@ class NodeReferenceUpdatingVisitor : public ASTVisitor {
           // make sure we don't muck with the assignment count on a builtin symbol!
           return true;
         }
-        sym->addAssignment();
+        sym->addDef(expr);
       }
       return true;
     };
 
     virtual bool visit(LSLIdentifier *id) {
-      LSLASTNode *upper_node = id->getParent();
-      while (upper_node != nullptr) {
-        // HACK: Make recursive calls not count as a reference, won't handle mutual recursion!
-        if (upper_node->getNodeType() == NODE_GLOBAL_FUNCTION) {
-          auto *ident = (LSLIdentifier *) upper_node->getChild(0);
-          if (ident != id && ident->getSymbol() == id->getSymbol())
-            return false;
-        }
-        upper_node = upper_node->getParent();
+      auto *symbol = id->getSymbol();
+      if (!symbol)
+        return false;
+      // any other reference to a user-defined function is a call
+      if (symbol->getSymbolType() == SYM_FUNCTION && symbol->getSubType() != SYM_BUILTIN && id != _mCurrentFuncId) {
+        _mCallGraph->addCall(_mCurrentFunc, symbol);
+        // Recursive calls don't count as a reference. Mutual recursion is
+        // handled by the call graph's reachability info instead.
+        if (symbol == _mCurrentFunc)
+          return false;
       }
-      if (auto *symbol = id->getSymbol())
-        symbol->addReference();
+      symbol->addUse(id);
       return false;
     };
+
+  private:
+    CallGraph *_mCallGraph;
+    LSLSymbol *_mCurrentFunc = nullptr;
+    LSLIdentifier *_mCurrentFuncId = nullptr;
 };
 
 void LSLScript::recalculateReferenceData() {
+  if (mContext->overBudget())
+    return;
   // get updated mutation / reference counts
   mContext->table_manager->resetTracking();
-  auto visitor = NodeReferenceUpdatingVisitor();
+  _mCallGraph.clear();
+  auto visitor = NodeReferenceUpdatingVisitor(&_mCallGraph);
+  PassProfileScope profile_scope(mContext, "reference_data", &visitor);
   visit(&visitor);
+  _mCallGraph.finalize();
 }
 
 void LSLScript::optimize(const OptimizationOptions &ctx) {
-  int optimized;
-  do {
+  if (mContext->overBudget())
+    return;
+  if (ctx.inline_functions) {
+    FunctionInliningVisitor inlining_visitor(mContext->allocator);
+    {
+      PassProfileScope profile_scope(mContext, "inline_functions", &inlining_visitor);
+      visit(&inlining_visitor);
+    }
+    // the inlined copies need values worked out for where they ended up
+    if (inlining_visitor.mInlinedCalls)
+      propagateValues();
+  }
+  if (ctx.propagate_constants && ctx.fold_constants) {
+    TailslideOperationBehavior behavior(mContext->allocator, true, mContext->constants);
+    ConstantPropagatingVisitor propagating_visitor(&behavior, mContext->allocator, mContext->constants);
+    PassProfileScope profile_scope(mContext, "propagate_constants", &propagating_visitor);
+    visit(&propagating_visitor);
+  }
+  // before folding, so the copies left unused get pruned along with everything else.
+  if (ctx.propagate_copies) {
+    CopyPropagatingVisitor copy_visitor;
+    PassProfileScope profile_scope(mContext, "propagate_copies", &copy_visitor);
+    visit(&copy_visitor);
+  }
+
+  {
     TreeSimplifyingVisitor folding_visitor(ctx);
+    PassProfileScope profile_scope(mContext, "optimize", &folding_visitor);
+
+    // Fold and prune everything in one walk, keeping track of which symbols lose references
+    // along the way. Pruning one thing can only make the things it referenced prunable,
+    // so after that we only need to look at those rather than walking the whole tree again.
+    std::vector<LSLSymbol *> released_symbols;
+    mContext->released_symbols = &released_symbols;
     visit(&folding_visitor);
-    optimized = folding_visitor.mFoldedLevel;
-  } while (optimized);
+    // Folding may have dropped the last read of a store, and dropping a store may
+    // drop the last reference to a declaration.
+    if (ctx.prune_dead_stores) {
+      DeadStoreEliminatingVisitor dse_visitor(mContext->allocator);
+      PassProfileScope dse_profile_scope(mContext, "prune_dead_stores", &dse_visitor);
+      visit(&dse_visitor);
+    }
+    folding_visitor.pruneReleasedSymbols(this, released_symbols);
+    mContext->released_symbols = nullptr;
+    TRACE_COUNTER("folded_level", folding_visitor.mFoldedLevel);
+  }
+
+  // Only once everything's been folded, there's no point in keeping something
+  // in a local if it was going to become a constant anyway.
+  int moved_exprs = 0;
+  if (ctx.hoist_loop_invariants) {
+    LoopInvariantHoistingVisitor hoisting_visitor(mContext->allocator);
+    PassProfileScope profile_scope(mContext, "hoist_loop_invariants", &hoisting_visitor);
+    visit(&hoisting_visitor);
+    moved_exprs += hoisting_visitor.mHoistedExprs;
+  }
+  // whatever got hoisted may still share parts with something computed before the loop
+  if (ctx.eliminate_common_subexprs) {
+    SubexpressionEliminatingVisitor cse_visitor(mContext->allocator);
+    PassProfileScope profile_scope(mContext, "eliminate_common_subexprs", &cse_visitor);
+    visit(&cse_visitor);
+    moved_exprs += cse_visitor.mEliminatedExprs;
+  }
+  // A hoisted local can end up initialized with nothing but a read of a local CSE made,
+  // so give copy propagation another go and prune whatever copies that leaves unused.
+  if (moved_exprs && ctx.propagate_copies) {
+    std::vector<LSLSymbol *> released_symbols;
+    mContext->released_symbols = &released_symbols;
+    CopyPropagatingVisitor copy_visitor;
+    {
+      PassProfileScope profile_scope(mContext, "propagate_copies", &copy_visitor);
+      visit(&copy_visitor);
+    }
+    if (copy_visitor.mPropagatedCopies) {
+      if (ctx.prune_dead_stores) {
+        DeadStoreEliminatingVisitor dse_visitor(mContext->allocator);
+        PassProfileScope dse_profile_scope(mContext, "prune_dead_stores", &dse_visitor);
+        visit(&dse_visitor);
+      }
+      TreeSimplifyingVisitor pruning_visitor(ctx);
+      pruning_visitor.pruneReleasedSymbols(this, released_symbols);
+    }
+    mContext->released_symbols = nullptr;
+  }
 }
 
 
 void LSLScript::validateGlobals(bool mono_semantics) {
+  if (mContext->overBudget())
+    return;
   SimpleAssignableValidatingVisitor visitor(mono_semantics);
+  PassProfileScope profile_scope(mContext, "validate_globals", &visitor);
   visit(&visitor);
 }
 
@@ -277,6 +417,14 @@ LSLConstant *LSLExpression::getConstantValue() {
 }
 
 
+static bool is_pure_builtin_arg(LSLASTNode *node) {
+  auto *args = node->getParent();
+  if (!args || !args->getParent() || args->getParent()->getNodeSubType() != NODE_FUNCTION_EXPRESSION)
+    return false;
+  auto *func_expr = (LSLFunctionExpression *) args->getParent();
+  return func_expr->getArguments() == args && builtin_is_pure(func_expr->getSymbol());
+}
+
 LSLConstant *LSLLValueExpression::getConstantValue() {
   if (_mIsFoldable) {
     if (_mInGlobalContext && !_mConstantValue && getSymbol()) {
@@ -293,7 +441,8 @@ LSLConstant *LSLLValueExpression::getConstantValue() {
         top_foldable = current_node;
         current_node = current_node->getParent();
       }
-      if (top_foldable->getIType() == LST_LIST)
+      // A pure builtin only looks at the list it's passed, so that's fine.
+      if (top_foldable->getIType() == LST_LIST && !is_pure_builtin_arg(top_foldable))
         return nullptr;
     }
 
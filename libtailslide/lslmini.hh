@@ -11,6 +11,7 @@
 
 #include "loctype.hh"
 #include "symtab.hh"
+#include "call_graph.hh"
 #include "ast.hh"
 #include "types.hh"
 #include "strings.hh"
@@ -22,6 +23,7 @@ typedef float F32;
 typedef double F64;
 
 class LSLScript;
+class PassProfiler;
 
 /// Add a getter / setter field pair to an LSLASTNode subclass
 #define NODE_FIELD_GS(_typ, _name, _index)       \
@@ -49,6 +51,15 @@ struct ScriptContext {
   void *scanner = nullptr;
   bool collect_assertions = false;
   std::vector<std::pair<int, ErrorCode>> assertions;
+  // per-pass stats get recorded here if set, see profiler.hh
+  PassProfiler *profiler = nullptr;
+  // while the optimizer is running, symbols that lose a reference get queued here
+  std::vector<class LSLSymbol *> *released_symbols = nullptr;
+  // shared instances of constant values, see constant_pool.hh
+  class ConstantPool *constants = nullptr;
+
+  // passes should bail out early once the logger's diagnostic budget is blown
+  bool overBudget() const { return logger && logger->isOverBudget(); }
 };
 
 struct Vector3 {
@@ -101,15 +112,22 @@ class LSLIdentifier : public LSLASTNode {
 
     LSLIdentifier *clone();
 
+    // next identifier on the same symbol's use list, see `LSLSymbol::getFirstUse()`
+    LSLIdentifier *getNextUse() { return _mNextUse; }
+
   private:
+    friend class LSLSymbol;
     LSLSymbol                  *_mSymbol = nullptr;
     const char                      *_mName;
+    LSLSymbol *_mUseOf = nullptr;
+    LSLIdentifier *_mPrevUse = nullptr;
+    LSLIdentifier *_mNextUse = nullptr;
 };
 
 class LSLGlobalVariable : public LSLASTNode {
   public:
     LSLGlobalVariable( ScriptContext *ctx, class LSLIdentifier *identifier, class LSLExpression *value )
-      : LSLASTNode(ctx, 2, identifier, value) { DEBUG( LOG_DEBUG_SPAM, nullptr, "made a global var\n"); };
+      : LSLASTNode(ctx, 2, identifier, value) {};
     NODE_FIELD_GS(LSLIdentifier, Identifier, 0)
     NODE_FIELD_GS(class LSLExpression, Initializer, 1)
 
@@ -408,9 +426,16 @@ class LSLExpression : public LSLASTNode {
   void setOperation(LSLOperator op) {_mOperation = op;};
   void setResultNeeded(bool result_needed) { _mResultNeeded = result_needed; };
   bool getResultNeeded() { return _mResultNeeded; }
+  // next expression on the same symbol's def list, see `LSLSymbol::getFirstDef()`
+  LSLExpression *getNextDef() { return _mNextDef; }
   protected:
   LSLOperator _mOperation;
   bool _mResultNeeded = true;
+  private:
+  friend class LSLSymbol;
+  LSLSymbol *_mDefOf = nullptr;
+  LSLExpression *_mPrevDef = nullptr;
+  LSLExpression *_mNextDef = nullptr;
 };
 
 class LSLStatement : public LSLASTNode {
@@ -762,14 +787,31 @@ class LSLScript : public LSLASTNode {
     virtual std::string getNodeName() { return "script"; };
     virtual LSLNodeType getNodeType() { return NODE_SCRIPT; };
     virtual LSLSymbol *lookupSymbol(const char *name, LSLSymbolType sym_type);
+    virtual bool suggestSymbol(const char *name, LSLSymbolType sym_type, int max_dist, struct NameSuggestion &best);
 
     void optimize(const OptimizationOptions &ctx);
     void recalculateReferenceData();
     void validateGlobals(bool mono_semantics);
+
+    // Only valid after `recalculateReferenceData()`. Not kept up to date as the tree
+    // changes, but removing code can't make an unreachable function reachable.
+    CallGraph &getCallGraph() { return _mCallGraph; }
+
+  private:
+    CallGraph _mCallGraph {};
 };
 
 void tailslide_init_builtins(const char *builtins_file);
 
+// Named builtin profiles for dialects with their own set of builtins, like OpenSimulator's.
+// `tailslide_init_builtins()` registers the "default" profile and must be called first.
+// Builtins identical to ones in an existing profile share the same symbol. Not thread-safe.
+LSLSymbolTable *tailslide_add_builtins_profile(const char *name, const char *builtins_file);
+LSLSymbolTable *tailslide_get_builtins_profile(const char *name);
+// Compact binary form of a profile that can be mapped in without re-parsing
+bool tailslide_save_builtins_image(LSLSymbolTable *profile, const char *image_file);
+LSLSymbolTable *tailslide_load_builtins_image(const char *name, const char *image_file);
+
 }
 
 // make sure our define doesn't leak into the public API
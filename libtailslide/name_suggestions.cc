@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstring>
+
+#include "name_suggestions.hh"
+
+namespace Tailslide {
+
+static inline char fold_char(char c, bool fold_case) {
+  return fold_case ? (char)tolower((unsigned char)c) : c;
+}
+
+static int edit_distance(const char *a, const char *b, int max_dist, bool fold_case) {
+  const size_t a_len = strlen(a);
+  const size_t b_len = strlen(b);
+  const size_t len_diff = (a_len > b_len) ? a_len - b_len : b_len - a_len;
+  if (len_diff > (size_t)max_dist)
+    return max_dist + 1;
+
+  // Identifiers are nearly always short, only go to the heap for silly ones.
+  int stack_rows[2][64];
+  std::vector<int> heap_rows;
+  int *prev = stack_rows[0], *cur = stack_rows[1];
+  if (b_len + 1 > 64) {
+    heap_rows.resize((b_len + 1) * 2);
+    prev = &heap_rows[0];
+    cur = &heap_rows[b_len + 1];
+  }
+
+  for (size_t j = 0; j <= b_len; ++j)
+    prev[j] = (int)j;
+
+  for (size_t i = 1; i <= a_len; ++i) {
+    const char a_char = fold_char(a[i - 1], fold_case);
+    int row_min = cur[0] = (int)i;
+    for (size_t j = 1; j <= b_len; ++j) {
+      int cost = (a_char == fold_char(b[j - 1], fold_case)) ? 0 : 1;
+      cur[j] = std::min({prev[j] + 1, cur[j - 1] + 1, prev[j - 1] + cost});
+      row_min = std::min(row_min, cur[j]);
+    }
+    // every later row can only be at least this far off
+    if (row_min > max_dist)
+      return max_dist + 1;
+    std::swap(prev, cur);
+  }
+  return std::min(prev[b_len], max_dist + 1);
+}
+
+int folded_edit_distance(const char *a, const char *b, int max_dist) {
+  return edit_distance(a, b, max_dist, true);
+}
+
+void NameSuggestionIndex::insert(LSLSymbol *symbol) {
+  const char *name = symbol->getName();
+  const auto new_idx = (uint32_t)_mNodes.size();
+  _mNodes.push_back({name, symbol, NO_NODE, NO_NODE, 0});
+  if (new_idx == 0)
+    return;
+
+  uint32_t node_idx = 0;
+  for (;;) {
+    auto dist = (uint32_t)folded_edit_distance(name, _mNodes[node_idx].name, INT_MAX - 1);
+    // find the child sitting at the same distance, if any
+    uint32_t child_idx = _mNodes[node_idx].first_child;
+    while (child_idx != NO_NODE && _mNodes[child_idx].parent_dist != dist)
+      child_idx = _mNodes[child_idx].next_sibling;
+
+    if (child_idx == NO_NODE) {
+      _mNodes[new_idx].parent_dist = dist;
+      _mNodes[new_idx].next_sibling = _mNodes[node_idx].first_child;
+      _mNodes[node_idx].first_child = new_idx;
+      return;
+    }
+    node_idx = child_idx;
+  }
+}
+
+bool NameSuggestionIndex::findClosest(
+    const char *name, LSLSymbolType type, int max_dist, NameSuggestion &best) const {
+  if (_mNodes.empty() || max_dist <= 0)
+    return false;
+
+  bool found = false;
+  std::vector<uint32_t> stack;
+  stack.push_back(0);
+
+  while (!stack.empty()) {
+    const Node &node = _mNodes[stack.back()];
+    stack.pop_back();
+
+    // Only bother with nodes that could tie with or beat what we already have
+    int cutoff = best.symbol ? std::min(max_dist, best.distance) : max_dist;
+    // need the real distance rather than a bounded one so we can prune children correctly
+    int dist = folded_edit_distance(name, node.name, INT_MAX - 1);
+
+    if (dist <= cutoff && (type == SYM_ANY || node.symbol->getSymbolType() == type)) {
+      int exact_dist = edit_distance(name, node.name, INT_MAX - 1, false);
+      if (exact_dist != 0) {
+        bool better = !best.symbol
+            || dist < best.distance
+            || (dist == best.distance && exact_dist < best.exact_distance)
+            || (dist == best.distance && exact_dist == best.exact_distance
+                && strcmp(node.name, best.symbol->getName()) < 0);
+        if (better) {
+          best.symbol = node.symbol;
+          best.distance = dist;
+          best.exact_distance = exact_dist;
+          cutoff = dist;
+          found = true;
+        }
+      }
+    }
+
+    // Triangle inequality: anything under a child edge further than `cutoff`
+    // away from `dist` can't be within `cutoff` of the queried name.
+    for (uint32_t child_idx = node.first_child; child_idx != NO_NODE; child_idx = _mNodes[child_idx].next_sibling) {
+      int edge = (int)_mNodes[child_idx].parent_dist;
+      if (edge >= dist - cutoff && edge <= dist + cutoff)
+        stack.push_back(child_idx);
+    }
+  }
+  return found;
+}
+
+int NameSuggestionIndex::maxDistanceFor(const char *name) {
+  size_t len = strlen(name);
+  if (len < 3)
+    return 0;
+  if (len <= 5)
+    return 1;
+  if (len <= 10)
+    return 2;
+  return 3;
+}
+
+}
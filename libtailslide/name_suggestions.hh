@@ -0,0 +1,52 @@
+#ifndef TAILSLIDE_NAME_SUGGESTIONS_HH
+#define TAILSLIDE_NAME_SUGGESTIONS_HH
+
+#include <cstdint>
+#include <vector>
+
+#include "symtab.hh"
+
+namespace Tailslide {
+
+struct NameSuggestion {
+  LSLSymbol *symbol = nullptr;
+  // case-insensitive edit distance from the queried name
+  int distance = 0;
+  // tie breaker, distance that also counts case differences
+  int exact_distance = 0;
+};
+
+/// BK-tree over symbol names, used for "did you mean" suggestions.
+/// Distances are Levenshtein distances over case-folded names, so lookups
+/// with a small cutoff only need to look at a small part of the tree.
+class NameSuggestionIndex {
+  public:
+    void insert(LSLSymbol *symbol);
+    void clear() { _mNodes.clear(); }
+    size_t size() const { return _mNodes.size(); }
+
+    /// Find the closest symbol of type `type` within `max_dist` edits of `name`,
+    /// replacing `best` if it's a better match than what's already there.
+    /// Symbols with exactly the queried name are never suggested.
+    bool findClosest(const char *name, LSLSymbolType type, int max_dist, NameSuggestion &best) const;
+
+    /// Max number of edits a name may be from a suggestion before it's considered noise.
+    static int maxDistanceFor(const char *name);
+
+  private:
+    struct Node {
+      const char *name;
+      LSLSymbol *symbol;
+      uint32_t first_child;
+      uint32_t next_sibling;
+      uint32_t parent_dist;
+    };
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+    std::vector<Node> _mNodes {};
+};
+
+int folded_edit_distance(const char *a, const char *b, int max_dist);
+
+}
+
+#endif
@@ -1,10 +1,14 @@
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <set>
+#include <unordered_map>
 
 #include "lslmini.hh"
 #include "allocator.hh"
+#include "constant_pool.hh"
 #include "operations.hh"
+#include "unordered_cstr_map.hh"
 
 
 #define RET_IF_ZERO(_x) if(!(_x)) return NULL
@@ -17,6 +21,10 @@ LSLConstant *TailslideOperationBehavior::operation(
   auto *left_type = cv->getType();
   LSLConstant *new_cv = nullptr;
 
+  // No point dispatching if the types involved can't produce a result at all
+  if (!left_type->getResultType(oper, other_cv ? other_cv->getType() : nullptr))
+    return nullptr;
+
   switch (left_type->getIType()) {
     case LST_STRING:
       new_cv = operation(oper, (LSLStringConstant*)cv, other_cv);
@@ -44,7 +52,8 @@ LSLConstant *TailslideOperationBehavior::operation(
     case LST_ERROR:
       return nullptr;
   }
-  if (new_cv)
+  // pooled constants are shared, they can't have a location of their own
+  if (new_cv && !new_cv->isStatic())
     new_cv->setLoc(lloc);
   return new_cv;
 }
@@ -70,7 +79,7 @@ LSLConstant *TailslideOperationBehavior::operation(
       default:
         return nullptr;
     }
-    return _mAllocator->newTracked<LSLIntegerConstant>(nv);
+    return _mConstants->getInteger(nv);
   }
 
   // binary op
@@ -141,7 +150,7 @@ LSLConstant *TailslideOperationBehavior::operation(
         default:
           return nullptr;
       }
-      return _mAllocator->newTracked<LSLIntegerConstant>(nv);
+      return _mConstants->getInteger(nv);
     }
     case NODE_FLOAT_CONSTANT: {
       F64 ov = ((LSLFloatConstant *) other_const)->getValue();
@@ -162,17 +171,17 @@ LSLConstant *TailslideOperationBehavior::operation(
           nv = (F64)value / ov;
           break;
         case '>':
-          return _mAllocator->newTracked<LSLIntegerConstant>((F64) value > ov);
+          return _mConstants->getInteger((F64) value > ov);
         case '<':
-          return _mAllocator->newTracked<LSLIntegerConstant>((F64) value < ov);
+          return _mConstants->getInteger((F64) value < ov);
         case OP_EQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>((F64) value == ov);
+          return _mConstants->getInteger((F64) value == ov);
         case OP_NEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>((F64) value != ov);
+          return _mConstants->getInteger((F64) value != ov);
         default:
           return nullptr;
       }
-      return _mAllocator->newTracked<LSLFloatConstant>(nv);
+      return _mConstants->getFloat(nv);
     }
     default:
       return nullptr;
@@ -187,7 +196,7 @@ LSLConstant *TailslideOperationBehavior::operation(
   // unary op
   if (other_const == nullptr) {
     if (operation == '-')
-      return _mAllocator->newTracked<LSLFloatConstant>(-value);
+      return _mConstants->getFloat(-value);
     return nullptr;
   }
 
@@ -211,25 +220,25 @@ LSLConstant *TailslideOperationBehavior::operation(
           nv = value / (F64)ov;
           break;
         case '>':
-          return _mAllocator->newTracked<LSLIntegerConstant>(value > (F64) ov);
+          return _mConstants->getInteger(value > (F64) ov);
         case '<':
-          return _mAllocator->newTracked<LSLIntegerConstant>(value < (F64) ov);
+          return _mConstants->getInteger(value < (F64) ov);
         case OP_GEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(value >= (F64) ov);
+          return _mConstants->getInteger(value >= (F64) ov);
         case OP_LEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(value <= (F64) ov);
+          return _mConstants->getInteger(value <= (F64) ov);
         case OP_BOOLEAN_AND:
-          return _mAllocator->newTracked<LSLIntegerConstant>(value != 0.0 && ov);
+          return _mConstants->getInteger(value != 0.0 && ov);
         case OP_BOOLEAN_OR:
-          return _mAllocator->newTracked<LSLIntegerConstant>(value != 0.0 || ov);
+          return _mConstants->getInteger(value != 0.0 || ov);
         case OP_EQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(value == (F64) ov);
+          return _mConstants->getInteger(value == (F64) ov);
         case OP_NEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(value != (F64) ov);
+          return _mConstants->getInteger(value != (F64) ov);
         default:
           return nullptr;
       }
-      return _mAllocator->newTracked<LSLFloatConstant>(nv);
+      return _mConstants->getFloat(nv);
     }
     case NODE_FLOAT_CONSTANT: {
       double ov = ((LSLFloatConstant *) other_const)->getValue();
@@ -249,21 +258,21 @@ LSLConstant *TailslideOperationBehavior::operation(
           nv = value / ov;
           break;
         case '>':
-          return _mAllocator->newTracked<LSLIntegerConstant>(value > ov);
+          return _mConstants->getInteger(value > ov);
         case '<':
-          return _mAllocator->newTracked<LSLIntegerConstant>(value < ov);
+          return _mConstants->getInteger(value < ov);
         case OP_GEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(value >= ov);
+          return _mConstants->getInteger(value >= ov);
         case OP_LEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(value <= ov);
+          return _mConstants->getInteger(value <= ov);
         case OP_EQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(value == ov);
+          return _mConstants->getInteger(value == ov);
         case OP_NEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(value != ov);
+          return _mConstants->getInteger(value != ov);
         default:
           return nullptr;
       }
-      return _mAllocator->newTracked<LSLFloatConstant>(nv);
+      return _mConstants->getFloat(nv);
     }
     default:
       return nullptr;
@@ -288,15 +297,15 @@ LSLConstant *TailslideOperationBehavior::operation(
       switch (operation) {
         case '+':
           if (_mMayCreateHeapValues) {
-            return _mAllocator->newTracked<LSLStringConstant>(joinString(value, ov));
+            return _mConstants->getString((std::string(value) + ov).c_str());
           } else {
             return nullptr;
           }
         case OP_EQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(!strcmp(value, ov));
+          return _mConstants->getInteger(!strcmp(value, ov));
           // If you want LSO's behaviour, remove the `!= 0`.
         case OP_NEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(strcmp(value, ov) != 0);
+          return _mConstants->getInteger(strcmp(value, ov) != 0);
         default:
           return nullptr;
       }
@@ -305,10 +314,10 @@ LSLConstant *TailslideOperationBehavior::operation(
       const char *ov = ((LSLStringConstant *) other_const)->getValue();
       switch (operation) {
         case OP_EQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(!strcmp(value, ov));
+          return _mConstants->getInteger(!strcmp(value, ov));
           // If you want LSO's behaviour, remove the `!= 0`.
         case OP_NEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(strcmp(value, ov) != 0);
+          return _mConstants->getInteger(strcmp(value, ov) != 0);
         default:
           return nullptr;
       }
@@ -336,10 +345,10 @@ LSLConstant *TailslideOperationBehavior::operation(
       const char *ov = ((LSLStringConstant *) other_const)->getValue();
       switch (operation) {
         case OP_EQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(!strcmp(value, ov));
+          return _mConstants->getInteger(!strcmp(value, ov));
           // If you want LSO's behaviour, remove the `!= 0`.
         case OP_NEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(strcmp(value, ov) != 0);
+          return _mConstants->getInteger(strcmp(value, ov) != 0);
         default:
           return nullptr;
       }
@@ -364,12 +373,12 @@ LSLConstant *TailslideOperationBehavior::operation(
       LSLListConstant *other = ((LSLListConstant *) other_const);
       switch (operation) {
         case OP_EQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(
+          return _mConstants->getInteger(
               cv->getLength() == other->getLength()
           );
         case OP_NEQ:
           // Yes, really.
-          return _mAllocator->newTracked<LSLIntegerConstant>(
+          return _mConstants->getInteger(
               cv->getLength() - other->getLength()
           );
         default:
@@ -394,7 +403,7 @@ LSLConstant *TailslideOperationBehavior::operation(
   // unary op
   if (other_const == nullptr) {
     if (operation == '-')
-      return _mAllocator->newTracked<LSLVectorConstant>(-value->x, -value->y, -value->z);
+      return _mConstants->getVector(-value->x, -value->y, -value->z);
     else
       return nullptr;
   }
@@ -419,7 +428,7 @@ LSLConstant *TailslideOperationBehavior::operation(
         default:
           return nullptr;
       }
-      return _mAllocator->newTracked<LSLVectorConstant>(nv[0], nv[1], nv[2]);
+      return _mConstants->getVector(nv[0], nv[1], nv[2]);
     }
     case NODE_FLOAT_CONSTANT: {
       // TODO: are these operations done in double or single space?
@@ -440,7 +449,7 @@ LSLConstant *TailslideOperationBehavior::operation(
         default:
           return nullptr;
       }
-      return _mAllocator->newTracked<LSLVectorConstant>(nv[0], nv[1], nv[2]);
+      return _mConstants->getVector(nv[0], nv[1], nv[2]);
     }
     case NODE_VECTOR_CONSTANT: {
       const Vector3 *ov = ((LSLVectorConstant *) other_const)->getValue();
@@ -459,20 +468,20 @@ LSLConstant *TailslideOperationBehavior::operation(
           nv[2] = value->z - ov->z;
           break;
         case '*':
-          return _mAllocator->newTracked<LSLFloatConstant>((value->x * ov->z) + (value->y * ov->y) + (value->z * ov->x));
+          return _mConstants->getFloat((value->x * ov->z) + (value->y * ov->y) + (value->z * ov->x));
         case '%':           // cross product
           nv[0] = (value->y * ov->z) - (value->z * ov->y);
           nv[1] = (value->z * ov->x) - (value->x * ov->z);
           nv[2] = (value->x * ov->y) - (value->y * ov->x);
           break;
         case OP_EQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(*value == *ov);
+          return _mConstants->getInteger(*value == *ov);
         case OP_NEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(*value != *ov);
+          return _mConstants->getInteger(*value != *ov);
         default:
           return nullptr;
       }
-      return _mAllocator->newTracked<LSLVectorConstant>(nv[0], nv[1], nv[2]);
+      return _mConstants->getVector(nv[0], nv[1], nv[2]);
     }
     default:
       return nullptr;
@@ -490,7 +499,7 @@ LSLConstant *TailslideOperationBehavior::operation(
   // unary op
   if (other_const == nullptr) {
     if (operation == '-')
-      return _mAllocator->newTracked<LSLQuaternionConstant>(-value->x, -value->y, -value->z, -value->s);
+      return _mConstants->getQuaternion(-value->x, -value->y, -value->z, -value->s);
     else
       return nullptr;
   }
@@ -503,11 +512,11 @@ LSLConstant *TailslideOperationBehavior::operation(
         return nullptr;
       switch (operation) {
         case OP_EQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(*value == *ov);
+          return _mConstants->getInteger(*value == *ov);
         case OP_NEQ:
-          return _mAllocator->newTracked<LSLIntegerConstant>(*value != *ov);
+          return _mConstants->getInteger(*value != *ov);
         case '-':
-          return _mAllocator->newTracked<LSLQuaternionConstant>(value->x - ov->x, value->y - ov->y, value->z - ov->z,
+          return _mConstants->getQuaternion(value->x - ov->x, value->y - ov->y, value->z - ov->z,
                                                                value->s - ov->s);
         default:
           return nullptr;
@@ -568,7 +577,8 @@ LSLConstant *TailslideOperationBehavior::cast(LSLType *to_type, LSLConstant *cv,
     case LST_ERROR:
       return nullptr;
   }
-  if (new_cv)
+  // pooled constants are shared, they can't have a location of their own
+  if (new_cv && !new_cv->isStatic())
     new_cv->setLoc(lloc);
   return new_cv;
 }
@@ -587,14 +597,14 @@ LSLConstant *TailslideOperationBehavior::cast(LSLType *to_type, LSLStringConstan
         base = 16;
       // This strtoul is weird in that we're using a signed int, but it matches
       // the behavior of upstream, so whatever.
-      return _mAllocator->newTracked<LSLIntegerConstant>((S32) strtoul(v, nullptr, base));
+      return _mConstants->getInteger((S32) strtoul(v, nullptr, base));
     }
     case LST_FLOATINGPOINT: {
       // We intentionally truncate precision here to match Mono
-      return _mAllocator->newTracked<LSLFloatConstant>((F32)atof(v));
+      return _mConstants->getFloat((F32)atof(v));
     }
     case LST_KEY:
-      return _mAllocator->newTracked<LSLKeyConstant>(v);
+      return _mConstants->getKey(v);
     default:
       return nullptr;
   }
@@ -604,7 +614,7 @@ LSLConstant *TailslideOperationBehavior::cast(LSLType *to_type, LSLKeyConstant *
   auto *v = cv->getValue();
   switch(to_type->getIType()) {
     case LST_STRING:
-      return _mAllocator->newTracked<LSLStringConstant>(v);
+      return _mConstants->getString(v);
     default:
       return nullptr;
   }
@@ -614,14 +624,12 @@ LSLConstant *TailslideOperationBehavior::cast(LSLType *to_type, LSLIntegerConsta
   auto v = cv->getValue();
   switch(to_type->getIType()) {
     case LST_STRING: {
-      return _mAllocator->newTracked<LSLStringConstant>(
-          _mAllocator->copyStr(std::to_string(v).c_str())
-      );
+      return _mConstants->getString(std::to_string(v).c_str());
     }
     case LST_FLOATINGPOINT:
       // We use full 64-bit precision here. This is correct in Mono but
       // incorrect under LSO.
-      return _mAllocator->newTracked<LSLFloatConstant>((F64)v);
+      return _mConstants->getFloat((F64)v);
     default:
       return nullptr;
   }
@@ -650,9 +658,7 @@ LSLConstant *TailslideOperationBehavior::cast(LSLType *to_type, LSLFloatConstant
       else if (NAN_STRS.find(f_as_str) != NAN_STRS.end())
         f_as_str = "NaN";
 
-      return _mAllocator->newTracked<LSLStringConstant>(
-          _mAllocator->copyStr(f_as_str.c_str())
-      );
+      return _mConstants->getString(f_as_str.c_str());
     }
     case LST_INTEGER: {
       // Cast to float first - this is how LSL-on-Mono works.
@@ -673,11 +679,145 @@ LSLConstant *TailslideOperationBehavior::cast(LSLType *to_type, LSLFloatConstant
       } else {
         new_val = INT32_MIN;
       }
-      return _mAllocator->newTracked<LSLIntegerConstant>(new_val);
+      return _mConstants->getInteger(new_val);
     }
     default:
       return nullptr;
   }
 }
 
+//////////////////////////////////////////////
+// Builtin Function Calls
+
+typedef LSLConstant *(TailslideOperationBehavior::*BuiltinEvaluator)(LSLConstant **args);
+
+static const std::unordered_map<const char *, BuiltinEvaluator, CStrHash<const char *>, CStrEqualTo<const char *>> BUILTIN_EVALUATORS {
+    {"llAbs", &TailslideOperationBehavior::callAbs},
+    {"llStringLength", &TailslideOperationBehavior::callStringLength},
+    {"llList2Integer", &TailslideOperationBehavior::callList2Integer},
+    {"llVecMag", &TailslideOperationBehavior::callVecMag},
+    {"llPow", &TailslideOperationBehavior::callPow},
+    {"llGetSubString", &TailslideOperationBehavior::callGetSubString},
+};
+
+LSLConstant *TailslideOperationBehavior::call(LSLSymbol *func_sym, LSLConstant **args, YYLTYPE *lloc) {
+  if (func_sym->getSubType() != SYM_BUILTIN || !func_sym->hasBuiltinAttr(BUILTIN_ATTR_PURE))
+    return nullptr;
+  auto eval_iter = BUILTIN_EVALUATORS.find(func_sym->getName());
+  if (eval_iter == BUILTIN_EVALUATORS.end())
+    return nullptr;
+  LSLConstant *new_cv = (this->*eval_iter->second)(args);
+  // pooled constants are shared, they can't have a location of their own
+  if (new_cv && !new_cv->isStatic())
+    new_cv->setLoc(lloc);
+  return new_cv;
+}
+
+// Mono strings are UTF-16 and LSO strings are UTF-8, they only agree
+// on where characters start and end for plain ASCII.
+static bool is_ascii(const char *str) {
+  for (; *str; ++str) {
+    if ((unsigned char)*str >= 0x80)
+      return false;
+  }
+  return true;
+}
+
+LSLConstant *TailslideOperationBehavior::callAbs(LSLConstant **args) {
+  S32 value = ((LSLIntegerConstant *) args[0])->getValue();
+  // -2147483648 has no positive counterpart, it stays as it is.
+  if (value == INT32_MIN)
+    return _mConstants->getInteger(value);
+  return _mConstants->getInteger(value < 0 ? -value : value);
+}
+
+LSLConstant *TailslideOperationBehavior::callStringLength(LSLConstant **args) {
+  const char *value = ((LSLStringConstant *) args[0])->getValue();
+  if (!is_ascii(value))
+    return nullptr;
+  return _mConstants->getInteger((S32) strlen(value));
+}
+
+LSLConstant *TailslideOperationBehavior::callList2Integer(LSLConstant **args) {
+  auto *list_cv = (LSLListConstant *) args[0];
+  S32 index = ((LSLIntegerConstant *) args[1])->getValue();
+  S32 length = list_cv->getLength();
+  // negative indices count from the end, anything out of range gives 0
+  if (index < 0)
+    index += length;
+  if (index < 0 || index >= length)
+    return _mConstants->getInteger(0);
+
+  auto *entry = list_cv->getChild(index);
+  switch (entry->getIType()) {
+    case LST_INTEGER:
+      return _mConstants->getInteger(((LSLIntegerConstant *) entry)->getValue());
+    // these convert the same way as a cast would
+    case LST_FLOATINGPOINT:
+      return cast(TYPE(LST_INTEGER), (LSLFloatConstant *) entry);
+    case LST_STRING:
+      return cast(TYPE(LST_INTEGER), (LSLStringConstant *) entry);
+    case LST_VECTOR:
+    case LST_QUATERNION:
+      return _mConstants->getInteger(0);
+    default:
+      // LSO and Mono don't agree on keys
+      return nullptr;
+  }
+}
+
+LSLConstant *TailslideOperationBehavior::callVecMag(LSLConstant **args) {
+  auto *vec = ((LSLVectorConstant *) args[0])->getValue();
+  // Everything up to the square root happens in single precision
+  F32 mag_sq = vec->x * vec->x + vec->y * vec->y + vec->z * vec->z;
+  auto mag = (F32) sqrt((F64) mag_sq);
+  if (!std::isfinite(mag))
+    return nullptr;
+  return _mConstants->getFloat(mag);
+}
+
+LSLConstant *TailslideOperationBehavior::callPow(LSLConstant **args) {
+  auto base = (F32) ((LSLFloatConstant *) args[0])->getValue();
+  auto exponent = (F32) ((LSLFloatConstant *) args[1])->getValue();
+  auto result = (F32) pow((F64) base, (F64) exponent);
+  // LSL has no literals for these, leave the call in.
+  if (!std::isfinite(result))
+    return nullptr;
+  return _mConstants->getFloat(result);
+}
+
+LSLConstant *TailslideOperationBehavior::callGetSubString(LSLConstant **args) {
+  const char *value = ((LSLStringConstant *) args[0])->getValue();
+  if (!_mMayCreateHeapValues || !is_ascii(value))
+    return nullptr;
+  auto length = (S32) strlen(value);
+  S32 start = ((LSLIntegerConstant *) args[1])->getValue();
+  S32 end = ((LSLIntegerConstant *) args[2])->getValue();
+  if (!length)
+    return _mConstants->getString("");
+  // negative indices count from the end
+  if (start < 0)
+    start += length;
+  if (end < 0)
+    end += length;
+
+  std::string sub_str;
+  if (start <= end) {
+    // the range gets clipped to the string
+    if (start < length && end >= 0) {
+      start = std::max(start, 0);
+      end = std::min(end, length - 1);
+      sub_str.assign(value + start, end - start + 1);
+    }
+  } else {
+    // Everything _but_ the characters between `end` and `start`.
+    // Don't try to guess what happens if either is out of range.
+    if (end < 0 || start >= length)
+      return nullptr;
+    sub_str.assign(value, end + 1);
+    sub_str.append(value + start);
+  }
+  return _mConstants->getString(sub_str.c_str());
+}
+
 }
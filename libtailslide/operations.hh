@@ -1,6 +1,7 @@
 #pragma once
 
 #include "allocator.hh"
+#include "constant_pool.hh"
 
 struct YYLTYPE;
 
@@ -13,6 +14,7 @@ class LSLFloatConstant;
 class LSLListConstant;
 class LSLQuaternionConstant;
 class LSLVectorConstant;
+class LSLSymbol;
 
 class AOperationBehavior {
   public:
@@ -20,15 +22,23 @@ class AOperationBehavior {
         LSLOperator oper, LSLConstant *cv, LSLConstant *other_cv, YYLTYPE *lloc) = 0;
     virtual LSLConstant *cast(
         LSLType *to_type, LSLConstant *cv, YYLTYPE *lloc) = 0;
+    // result of calling a pure builtin function, `args` already match its parameter types.
+    // Calls are never evaluated unless the behavior knows how.
+    virtual LSLConstant *call(
+        LSLSymbol *func_sym, LSLConstant **args, YYLTYPE *lloc) { return nullptr; }
 };
 
 // Arbitrary operation behavior implemented by Tailslide itself. May not match the target platform's
 // runtime operation behavior!
 class TailslideOperationBehavior : public AOperationBehavior {
   public:
-    explicit TailslideOperationBehavior(ScriptAllocator *allocator, bool create_heap_values=false) {
+    explicit TailslideOperationBehavior(
+        ScriptAllocator *allocator, bool create_heap_values=false, ConstantPool *constants=nullptr)
+        : _mOwnConstants(allocator) {
       _mAllocator = allocator;
       _mMayCreateHeapValues = create_heap_values;
+      // results are only shared for as long as the behavior lives if there's no script-wide pool
+      _mConstants = constants ? constants : &_mOwnConstants;
     };
     // dispatch method
     LSLConstant *operation(
@@ -55,15 +65,22 @@ class TailslideOperationBehavior : public AOperationBehavior {
     LSLConstant *cast(LSLType *to_type, LSLVectorConstant *cv) { return nullptr; };
     LSLConstant *cast(LSLType *to_type, LSLQuaternionConstant *cv) { return nullptr; };
 
+    // dispatch method
+    LSLConstant *call(LSLSymbol *func_sym, LSLConstant **args, YYLTYPE *lloc) override;
+
+    // builtin-specific call methods
+    LSLConstant *callAbs(LSLConstant **args);
+    LSLConstant *callStringLength(LSLConstant **args);
+    LSLConstant *callList2Integer(LSLConstant **args);
+    LSLConstant *callVecMag(LSLConstant **args);
+    LSLConstant *callPow(LSLConstant **args);
+    LSLConstant *callGetSubString(LSLConstant **args);
+
   protected:
-    inline char *joinString(const char *left, const char *right) {
-      char *ns = _mAllocator->alloc(strlen(left) + strlen(right) + 1);
-      strcpy(ns, left);
-      strcat(ns, right);
-      return ns;
-    }
     ScriptAllocator *_mAllocator;
     bool _mMayCreateHeapValues;
+    ConstantPool *_mConstants;
+    ConstantPool _mOwnConstants;
 };
 
 }
@@ -0,0 +1,244 @@
+#include "constant_propagation.hh"
+
+namespace Tailslide {
+
+static LSLSymbol *get_assigned_symbol(LSLExpression *expr) {
+  return ((LSLLValueExpression *) expr->getChild(0))->getSymbol();
+}
+
+bool ConstantPropagatingVisitor::visit(LSLScript *script) {
+  for (auto *child : *script->getGlobals()) {
+    if (child->getNodeType() == NODE_GLOBAL_FUNCTION)
+      propagate(child);
+  }
+  for (auto *state : *script->getStates()) {
+    if (auto *handlers = state->getEventHandlers()) {
+      for (auto *handler : *handlers)
+        propagate(handler);
+    }
+  }
+  return false;
+}
+
+void ConstantPropagatingVisitor::trackSymbol(LSLSymbol *sym) {
+  if (!sym || sym->getIType() == LST_ERROR || _mSlots.find(sym) != _mSlots.end())
+    return;
+  auto slot = (uint32_t)_mSlots.size();
+  _mSlots[sym] = slot;
+}
+
+void ConstantPropagatingVisitor::propagate(LSLASTNode *func) {
+  _mSlots.clear();
+  _mNodeDefs.clear();
+  _mGraph.build(func);
+  auto &blocks = _mGraph.getBlocks();
+
+  // Every local declared in the body gets tracked, parameters only matter if they're assigned to.
+  // Both function and event handler nodes keep their parameters in the second child.
+  for (auto *param : *func->getChild(1)) {
+    auto *sym = param->getSymbol();
+    if (sym && sym->getAssignments() > 0)
+      trackSymbol(sym);
+  }
+  for (auto &block : blocks) {
+    for (auto *node : block.nodes) {
+      _mNodeDefs[node];
+      if (node->getNodeSubType() == NODE_DECLARATION)
+        trackSymbol(node->getSymbol());
+    }
+  }
+  if (_mSlots.empty())
+    return;
+
+  // Figure out which node each assignment happens under
+  for (auto &slot : _mSlots) {
+    for (auto *def = slot.first->getFirstDef(); def; def = def->getNextDef()) {
+      LSLASTNode *owner = def;
+      while (owner && _mNodeDefs.find(owner) == _mNodeDefs.end())
+        owner = owner->getParent();
+      if (owner)
+        _mNodeDefs[owner].push_back(def);
+    }
+  }
+
+  // Parameters and locals we jumped over the declaration of could hold anything on entry.
+  // Blocks that haven't been reached yet have no state, they'll take whatever flows in first.
+  std::vector<FlowState> in_states(blocks.size());
+  std::vector<bool> reached(blocks.size(), false);
+  in_states[ControlFlowGraph::ENTRY_BLOCK].assign(_mSlots.size(), nullptr);
+  reached[ControlFlowGraph::ENTRY_BLOCK] = true;
+
+  // Values only ever go from unknown to constant to varying, so this settles quickly.
+  // Nothing changed during the last sweep, so every reachable node was last evaluated
+  // against its final state.
+  FlowState state;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    _mResolvedReads.clear();
+    for (uint32_t block_idx : _mGraph.getReversePostOrder()) {
+      if (!reached[block_idx])
+        continue;
+      state = in_states[block_idx];
+      transfer(blocks[block_idx], state);
+      for (uint32_t succ : blocks[block_idx].succs) {
+        if (!reached[succ]) {
+          reached[succ] = true;
+          in_states[succ] = state;
+          changed = true;
+        } else if (mergeInto(in_states[succ], state)) {
+          changed = true;
+        }
+      }
+    }
+  }
+  // The type checker won't fold reads that come after a label, since it can't tell
+  // what jumps there. The graph can, so whatever it settled on is safe to fold.
+  for (auto *lvalue : _mResolvedReads)
+    lvalue->setIsFoldable(true);
+  _mResolvedReads.clear();
+}
+
+void ConstantPropagatingVisitor::transfer(FlowBlock &block, FlowState &state) {
+  for (auto *node : block.nodes) {
+    auto &defs = _mNodeDefs[node];
+    _mClobbered.clear();
+    for (auto *def : defs) {
+      if (def != node)
+        _mClobbered.push_back(get_assigned_symbol(def));
+    }
+
+    _mState = &state;
+    node->visit(this);
+    _mState = nullptr;
+
+    for (auto *sym : _mClobbered)
+      state[_mSlots[sym]] = nullptr;
+
+    if (node->getNodeSubType() == NODE_DECLARATION) {
+      auto *decl = (LSLDeclaration *) node;
+      auto *sym = decl->getSymbol();
+      auto slot_iter = _mSlots.find(sym);
+      if (slot_iter == _mSlots.end())
+        continue;
+      auto *rvalue = decl->getInitializer();
+      state[slot_iter->second] = rvalue ? coerceTo(sym, rvalue->getConstantValue()) : sym->getType()->getDefaultValue();
+    } else {
+      for (auto *def : defs) {
+        if (def == node)
+          state[_mSlots[get_assigned_symbol(def)]] = getAssignedValue(def, state);
+      }
+    }
+  }
+}
+
+bool ConstantPropagatingVisitor::mergeInto(FlowState &dest, const FlowState &src) {
+  bool changed = false;
+  for (size_t i = 0; i < dest.size(); ++i) {
+    if (dest[i] && !constants_identical(dest[i], src[i])) {
+      dest[i] = nullptr;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+LSLConstant *ConstantPropagatingVisitor::getAssignedValue(LSLExpression *expr, FlowState &state) {
+  auto *lvalue = (LSLLValueExpression *) expr->getChild(0);
+  auto *sym = lvalue->getSymbol();
+  // assigning to a single member, not worth tracking.
+  if (lvalue->getMember())
+    return nullptr;
+
+  const LSLOperator operation = expr->getOperation();
+  if (operation == OP_ASSIGN)
+    return coerceTo(sym, expr->getChild(1)->getConstantValue());
+
+  LSLConstant *old_value = state[_mSlots[sym]];
+  if (!old_value)
+    return nullptr;
+  LSLConstant *new_value;
+  switch (operation) {
+    case OP_PRE_INCR:
+    case OP_POST_INCR:
+    case OP_PRE_DECR:
+    case OP_POST_DECR: {
+      LSLConstant *one;
+      if (sym->getIType() == LST_INTEGER)
+        one = _mConstants->getInteger(1);
+      else if (sym->getIType() == LST_FLOATINGPOINT)
+        one = _mConstants->getFloat(1.0f);
+      else
+        return nullptr;
+      LSLOperator step_op = (operation == OP_PRE_INCR || operation == OP_POST_INCR) ? OP_PLUS : OP_MINUS;
+      new_value = _mOperationBehavior->operation(step_op, old_value, one, expr->getLoc());
+      break;
+    }
+    default: {
+      LSLConstant *rvalue = expr->getChild(1)->getConstantValue();
+      if (!rvalue)
+        return nullptr;
+      new_value = _mOperationBehavior->operation(
+          decouple_compound_operation(operation), old_value, rvalue, expr->getLoc());
+      break;
+    }
+  }
+  // `int_val *= float_val` and friends don't end up with the type you'd expect, don't bother.
+  if (new_value && new_value->getIType() != sym->getIType())
+    return nullptr;
+  return new_value;
+}
+
+LSLConstant *ConstantPropagatingVisitor::coerceTo(LSLSymbol *sym, LSLConstant *cv) {
+  if (!cv || cv->getIType() == sym->getIType())
+    return cv;
+  // same implicit promotion the declaration handling does
+  if (cv->getType()->canCoerce(sym->getType()))
+    return _mOperationBehavior->cast(sym->getType(), cv, cv->getLoc());
+  return nullptr;
+}
+
+bool ConstantPropagatingVisitor::visit(LSLDeclaration *decl_stmt) {
+  // The symbol's flow-insensitive value is still what everything else goes by,
+  // the declared value only matters for the flow state.
+  return false;
+}
+
+bool ConstantPropagatingVisitor::visit(LSLLValueExpression *lvalue) {
+  auto *sym = lvalue->getSymbol();
+  auto slot_iter = sym ? _mSlots.find(sym) : _mSlots.end();
+  if (!_mState || slot_iter == _mSlots.end())
+    return ConstantDeterminingVisitor::visit(lvalue);
+
+  // the target of an assignment is never a read
+  auto *parent = lvalue->getParent();
+  if (parent && parent->getNodeType() == NODE_EXPRESSION && parent->getChild(0) == lvalue
+      && operation_mutates(((LSLExpression *) parent)->getOperation())) {
+    lvalue->setConstantValue(nullptr);
+    return true;
+  }
+
+  for (auto *clobbered : _mClobbered) {
+    if (clobbered == sym) {
+      lvalue->setConstantValue(nullptr);
+      return true;
+    }
+  }
+
+  LSLConstant *cv = (*_mState)[slot_iter->second];
+  if (!cv) {
+    // Locals that never get assigned to have the same value everywhere they can be read,
+    // even if we lost track of it somewhere along the way.
+    return ConstantDeterminingVisitor::visit(lvalue);
+  }
+  const char *member_name = nullptr;
+  if (auto *member = lvalue->getMember())
+    member_name = member->getName();
+  auto *read_cv = getMemberValue(cv, member_name);
+  lvalue->setConstantValue(read_cv);
+  if (read_cv)
+    _mResolvedReads.push_back(lvalue);
+  return true;
+}
+
+}
@@ -0,0 +1,52 @@
+#ifndef TAILSLIDE_CONSTANT_PROPAGATION_HH
+#define TAILSLIDE_CONSTANT_PROPAGATION_HH
+
+#include <unordered_map>
+#include <vector>
+
+#include "../control_flow.hh"
+#include "values.hh"
+
+namespace Tailslide {
+
+/// Flow-sensitive counterpart to `ConstantDeterminingVisitor` for locals that get assigned to.
+/// Runs a forward dataflow analysis over the control flow graph of each function and
+/// event handler, tracking which assigned locals and parameters hold a known constant
+/// at each point. Reads of those locals get that constant as their value, and so does
+/// anything computed from them, so `TreeSimplifyingVisitor` can fold them. Jumps and
+/// labels are part of the graph, so reads that follow a label get folded too.
+class ConstantPropagatingVisitor : public ConstantDeterminingVisitor {
+  public:
+    ConstantPropagatingVisitor(AOperationBehavior *behavior, ScriptAllocator *allocator, ConstantPool *constants=nullptr)
+        : ConstantDeterminingVisitor(behavior, allocator, constants) {}
+
+    virtual bool visit(LSLScript *script);
+    virtual bool visit(LSLDeclaration *decl_stmt);
+    virtual bool visit(LSLLValueExpression *lvalue);
+
+  protected:
+    // constant value of each tracked symbol, nullptr if it could be anything.
+    typedef std::vector<LSLConstant *> FlowState;
+
+    void propagate(LSLASTNode *func);
+    void trackSymbol(LSLSymbol *sym);
+    void transfer(FlowBlock &block, FlowState &state);
+    bool mergeInto(FlowState &dest, const FlowState &src);
+    LSLConstant *getAssignedValue(LSLExpression *expr, FlowState &state);
+    LSLConstant *coerceTo(LSLSymbol *sym, LSLConstant *cv);
+
+    ControlFlowGraph _mGraph {};
+    std::unordered_map<LSLSymbol *, uint32_t> _mSlots {};
+    // assignments to tracked symbols within each node in the graph
+    std::unordered_map<LSLASTNode *, std::vector<LSLExpression *>> _mNodeDefs {};
+    // symbols assigned somewhere inside the node being evaluated, other than at its top level.
+    // Their value anywhere in that node depends on evaluation order, so it's anyone's guess.
+    std::vector<LSLSymbol *> _mClobbered {};
+    FlowState *_mState = nullptr;
+    // reads given a value during the current sweep over the graph
+    std::vector<LSLLValueExpression *> _mResolvedReads {};
+};
+
+}
+
+#endif //TAILSLIDE_CONSTANT_PROPAGATION_HH
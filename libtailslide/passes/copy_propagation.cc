@@ -0,0 +1,166 @@
+#include "copy_propagation.hh"
+
+namespace Tailslide {
+
+static bool is_copy_source(LSLASTNode *node) {
+  if (!node || node->getNodeSubType() != NODE_LVALUE_EXPRESSION || ((LSLLValueExpression *) node)->getMember())
+    return false;
+  auto *sym = node->getSymbol();
+  return sym && sym->getSymbolType() == SYM_VARIABLE && sym->getSubType() != SYM_BUILTIN;
+}
+
+bool CopyPropagatingVisitor::visit(LSLScript *script) {
+  for (auto *child : *script->getGlobals()) {
+    if (child->getNodeType() == NODE_GLOBAL_FUNCTION)
+      propagate(child);
+  }
+  for (auto *state : *script->getStates()) {
+    if (auto *handlers = state->getEventHandlers()) {
+      for (auto *handler : *handlers)
+        propagate(handler);
+    }
+  }
+  return false;
+}
+
+void CopyPropagatingVisitor::propagate(LSLASTNode *func) {
+  // Substituting a copy of a copy only gives the read of the copy, so go
+  // again until the reads point at the original.
+  while (propagateOnce(func)) {}
+}
+
+void CopyPropagatingVisitor::findCopy(LSLASTNode *node) {
+  LSLSymbol *dest;
+  LSLASTNode *src_expr;
+  if (node->getNodeSubType() == NODE_DECLARATION) {
+    dest = node->getSymbol();
+    src_expr = ((LSLDeclaration *) node)->getInitializer();
+  } else if (node->getNodeType() == NODE_EXPRESSION && ((LSLExpression *) node)->getOperation() == OP_ASSIGN) {
+    // only plain assignments to locals, anything else can't have its result discarded
+    // or might be written to by a function call.
+    auto *lvalue = (LSLLValueExpression *) node->getChild(0);
+    if (lvalue->getMember() || node->getParent()->getNodeSubType() != NODE_EXPRESSION_STATEMENT)
+      return;
+    dest = lvalue->getSymbol();
+    if (!dest || dest->getSubType() == SYM_GLOBAL || dest->getSubType() == SYM_BUILTIN)
+      return;
+    src_expr = node->getChild(1);
+  } else {
+    return;
+  }
+  if (!dest || !is_copy_source(src_expr))
+    return;
+  auto *src = src_expr->getSymbol();
+  // A `key` holding a copy of a `string` or vice versa converts on the way in,
+  // reading the original instead would lose that.
+  if (src == dest || src->getIType() != dest->getIType())
+    return;
+  _mCopies.push_back({node, dest, src});
+}
+
+bool CopyPropagatingVisitor::propagateOnce(LSLASTNode *func) {
+  _mCopies.clear();
+  _mEffects.clear();
+  _mGraph.build(func);
+  auto &blocks = _mGraph.getBlocks();
+  for (auto &block : blocks) {
+    for (auto *node : block.nodes) {
+      findCopy(node);
+      _mEffects[node].collect(node);
+    }
+  }
+  if (_mCopies.empty())
+    return false;
+
+  // Nothing is a copy of anything on the way in. Everywhere else starts out with
+  // everything available and gets narrowed down by what reaches it.
+  auto &order = _mGraph.getReversePostOrder();
+  std::vector<CopySet> available_out(blocks.size(), CopySet(_mCopies.size(), true));
+  std::vector<CopySet> available_in(blocks.size(), CopySet(_mCopies.size(), true));
+  CopySet available;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (uint32_t block_idx : order) {
+      auto &block = blocks[block_idx];
+      available.assign(_mCopies.size(), block_idx != ControlFlowGraph::ENTRY_BLOCK);
+      for (uint32_t pred : block.preds) {
+        if (!_mGraph.isReachable(pred))
+          continue;
+        for (size_t i = 0; i < available.size(); ++i)
+          available[i] = available[i] && available_out[pred][i];
+      }
+      available_in[block_idx] = available;
+      for (auto *node : block.nodes)
+        transfer(node, available);
+      if (available != available_out[block_idx]) {
+        available_out[block_idx] = available;
+        changed = true;
+      }
+    }
+  }
+
+  bool substituted = false;
+  for (uint32_t block_idx : order) {
+    available = available_in[block_idx];
+    for (auto *node : blocks[block_idx].nodes) {
+      substituted = substituteReads(node, available) || substituted;
+      transfer(node, available);
+    }
+  }
+  return substituted;
+}
+
+void CopyPropagatingVisitor::transfer(LSLASTNode *node, CopySet &available) {
+  auto &effects = _mEffects[node];
+  for (size_t i = 0; i < _mCopies.size(); ++i) {
+    auto &copy = _mCopies[i];
+    if (copy.node == node)
+      available[i] = true;
+    else if (available[i] && effects.clobbers({copy.dest, copy.src}))
+      available[i] = false;
+  }
+}
+
+bool CopyPropagatingVisitor::substituteReads(LSLASTNode *node, const CopySet &available) {
+  // Evaluation order within a node is hard to reason about, so a copy whose
+  // sides get written to anywhere inside it isn't worth the trouble.
+  auto &effects = _mEffects[node];
+  CopySet usable(available);
+  bool any_usable = false;
+  for (size_t i = 0; i < _mCopies.size(); ++i) {
+    if (usable[i])
+      usable[i] = !effects.clobbers({_mCopies[i].dest, _mCopies[i].src});
+    any_usable = any_usable || usable[i];
+  }
+  return any_usable && substituteReadsUnder(node, usable);
+}
+
+bool CopyPropagatingVisitor::substituteReadsUnder(LSLASTNode *node, const CopySet &available) {
+  if (node->getNodeSubType() != NODE_LVALUE_EXPRESSION) {
+    bool substituted = false;
+    for (auto *child : *node)
+      substituted = substituteReadsUnder(child, available) || substituted;
+    return substituted;
+  }
+
+  auto *lvalue = (LSLLValueExpression *) node;
+  auto *sym = lvalue->getSymbol();
+  for (size_t i = 0; i < _mCopies.size(); ++i) {
+    auto &copy = _mCopies[i];
+    if (!available[i] || copy.dest != sym)
+      continue;
+    // the original might be shadowed by something else with the same name here
+    if (lvalue->lookupSymbol(copy.src->getName(), SYM_VARIABLE) != copy.src)
+      return false;
+    auto *id = lvalue->mContext->allocator->newTracked<LSLIdentifier>(
+        copy.src->getType(), copy.src->getName(), lvalue->getIdentifier()->getLoc());
+    id->setSymbol(copy.src);
+    lvalue->setIdentifier(id);
+    ++mPropagatedCopies;
+    return true;
+  }
+  return false;
+}
+
+}
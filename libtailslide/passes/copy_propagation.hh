@@ -0,0 +1,52 @@
+#ifndef TAILSLIDE_COPY_PROPAGATION_HH
+#define TAILSLIDE_COPY_PROPAGATION_HH
+
+#include <unordered_map>
+#include <vector>
+
+#include "../control_flow.hh"
+#include "../lslmini.hh"
+#include "../visitor.hh"
+#include "side_effects.hh"
+
+namespace Tailslide {
+
+/// Replaces reads of locals that hold a copy of another variable with reads of
+/// the variable itself, so `string a = b; llSay(0, a);` reads `b` directly.
+/// Runs a forward "available copies" analysis over the control flow graph of each
+/// function and event handler. A copy stops being available as soon as either side
+/// might be written to. Copies between differently typed variables are never
+/// propagated, so `key` and `string` keep behaving differently where they should.
+/// The copies themselves are left for local and dead store pruning to clean up.
+class CopyPropagatingVisitor : public ASTVisitor {
+  public:
+    virtual bool visit(LSLScript *script);
+
+    int mPropagatedCopies = 0;
+
+  protected:
+    // `dest` holds the same value as `src` after `node` is evaluated
+    struct Copy {
+      LSLASTNode *node;
+      LSLSymbol *dest;
+      LSLSymbol *src;
+    };
+    // whether each copy is still in effect, indexed the same as `_mCopies`.
+    typedef std::vector<bool> CopySet;
+
+    void propagate(LSLASTNode *func);
+    bool propagateOnce(LSLASTNode *func);
+    void findCopy(LSLASTNode *node);
+    void transfer(LSLASTNode *node, CopySet &available);
+    bool substituteReads(LSLASTNode *node, const CopySet &available);
+    bool substituteReadsUnder(LSLASTNode *node, const CopySet &available);
+
+    ControlFlowGraph _mGraph {};
+    std::vector<Copy> _mCopies {};
+    // what evaluating each node in the graph might write to
+    std::unordered_map<LSLASTNode *, SideEffects> _mEffects {};
+};
+
+}
+
+#endif //TAILSLIDE_COPY_PROPAGATION_HH
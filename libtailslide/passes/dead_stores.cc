@@ -0,0 +1,206 @@
+#include "dead_stores.hh"
+#include "side_effects.hh"
+#include "tree_simplifier.hh"
+
+namespace Tailslide {
+
+// An assignment whose result nobody looks at: the whole of an expression statement
+// or one of a `for`'s init or increment expressions.
+static bool is_standalone_store(LSLASTNode *node) {
+  if (node->getNodeType() != NODE_EXPRESSION || !operation_mutates(((LSLExpression *) node)->getOperation()))
+    return false;
+  auto *parent = node->getParent();
+  if (parent->getNodeSubType() == NODE_EXPRESSION_STATEMENT)
+    return true;
+  auto *grandparent = parent->getParent();
+  if (!grandparent || grandparent->getNodeSubType() != NODE_FOR_STATEMENT)
+    return false;
+  auto *for_stmt = (LSLForStatement *) grandparent;
+  return parent == for_stmt->getInitExprs() || parent == for_stmt->getIncrExprs();
+}
+
+// Whether the lvalue only gets written to, `foo.x = 1` keeps the rest of `foo`.
+static bool is_overwritten(LSLLValueExpression *lvalue) {
+  auto *parent = lvalue->getParent();
+  return parent->getNodeType() == NODE_EXPRESSION && parent->getChild(0) == lvalue
+      && ((LSLExpression *) parent)->getOperation() == OP_ASSIGN && !lvalue->getMember();
+}
+
+bool DeadStoreEliminatingVisitor::visit(LSLScript *script) {
+  for (auto *child : *script->getGlobals()) {
+    if (child->getNodeType() == NODE_GLOBAL_FUNCTION)
+      eliminate(child);
+  }
+  for (auto *state : *script->getStates()) {
+    if (auto *handlers = state->getEventHandlers()) {
+      for (auto *handler : *handlers)
+        eliminate(handler);
+    }
+  }
+  return false;
+}
+
+void DeadStoreEliminatingVisitor::trackSymbol(LSLSymbol *sym) {
+  if (!sym || sym->getIType() == LST_ERROR || _mSlots.find(sym) != _mSlots.end())
+    return;
+  auto slot = (uint32_t)_mSlots.size();
+  _mSlots[sym] = slot;
+}
+
+void DeadStoreEliminatingVisitor::eliminate(LSLASTNode *func) {
+  // Dropping a store may have been the last thing reading some other local,
+  // so keep going until there's nothing left to drop.
+  while (eliminateOnce(func)) {}
+}
+
+bool DeadStoreEliminatingVisitor::eliminateOnce(LSLASTNode *func) {
+  _mSlots.clear();
+  _mGraph.build(func);
+  auto &blocks = _mGraph.getBlocks();
+
+  // Both function and event handler nodes keep their parameters in the second child.
+  for (auto *param : *func->getChild(1))
+    trackSymbol(param->getSymbol());
+  for (auto &block : blocks) {
+    for (auto *node : block.nodes) {
+      if (node->getNodeSubType() == NODE_DECLARATION)
+        trackSymbol(node->getSymbol());
+    }
+  }
+  if (_mSlots.empty())
+    return false;
+
+  // Nothing is live on the way out, the function or handler is done with all of them.
+  auto &order = _mGraph.getReversePostOrder();
+  std::vector<LiveSet> live_in(blocks.size(), LiveSet(_mSlots.size(), false));
+  LiveSet live;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    // liveness flows backward, successors should go first
+    for (auto block_iter = order.rbegin(); block_iter != order.rend(); ++block_iter) {
+      auto &block = blocks[*block_iter];
+      live.assign(_mSlots.size(), false);
+      for (uint32_t succ : block.succs) {
+        for (size_t i = 0; i < live.size(); ++i)
+          live[i] = live[i] || live_in[succ][i];
+      }
+      for (auto node_iter = block.nodes.rbegin(); node_iter != block.nodes.rend(); ++node_iter)
+        transfer(*node_iter, live);
+      if (live != live_in[*block_iter]) {
+        live_in[*block_iter] = live;
+        changed = true;
+      }
+    }
+  }
+
+  // Only look for dead stores once the analysis is done, the graph points into the tree.
+  std::vector<LSLExpression *> dead_stores;
+  std::vector<LSLDeclaration *> dead_decls;
+  for (uint32_t block_idx : order) {
+    auto &block = blocks[block_idx];
+    live.assign(_mSlots.size(), false);
+    for (uint32_t succ : block.succs) {
+      for (size_t i = 0; i < live.size(); ++i)
+        live[i] = live[i] || live_in[succ][i];
+    }
+    for (auto node_iter = block.nodes.rbegin(); node_iter != block.nodes.rend(); ++node_iter) {
+      auto *node = *node_iter;
+      if (node->getNodeSubType() == NODE_DECLARATION) {
+        auto slot_iter = _mSlots.find(node->getSymbol());
+        if (slot_iter != _mSlots.end() && !live[slot_iter->second] && ((LSLDeclaration *) node)->getInitializer())
+          dead_decls.push_back((LSLDeclaration *) node);
+      } else if (is_standalone_store(node)) {
+        auto slot_iter = _mSlots.find(node->getChild(0)->getSymbol());
+        if (slot_iter != _mSlots.end() && !live[slot_iter->second])
+          dead_stores.push_back((LSLExpression *) node);
+      }
+      transfer(node, live);
+    }
+  }
+
+  bool removed = false;
+  for (auto *store : dead_stores)
+    removed = removeStore(store) || removed;
+  // after the stores, so we know if anything other than the declaration is left
+  for (auto *decl : dead_decls)
+    removed = removeInitializer(decl) || removed;
+  return removed;
+}
+
+LSLSymbol *DeadStoreEliminatingVisitor::getKilledSymbol(LSLASTNode *node) {
+  if (node->getNodeSubType() == NODE_DECLARATION)
+    return node->getSymbol();
+  if (node->getNodeType() != NODE_EXPRESSION || ((LSLExpression *) node)->getOperation() != OP_ASSIGN)
+    return nullptr;
+  auto *lvalue = (LSLLValueExpression *) node->getChild(0);
+  if (lvalue->getMember())
+    return nullptr;
+  return lvalue->getSymbol();
+}
+
+void DeadStoreEliminatingVisitor::transfer(LSLASTNode *node, LiveSet &live) {
+  // Going backward, so whatever the node reads is live before it even if it
+  // overwrites it. Any assignment nested deeper down only ever adds reads.
+  auto slot_iter = _mSlots.find(getKilledSymbol(node));
+  if (slot_iter != _mSlots.end())
+    live[slot_iter->second] = false;
+  addReads(node, live);
+}
+
+void DeadStoreEliminatingVisitor::addReads(LSLASTNode *node, LiveSet &live) {
+  if (node->getNodeSubType() == NODE_LVALUE_EXPRESSION) {
+    if (is_overwritten((LSLLValueExpression *) node))
+      return;
+    auto slot_iter = _mSlots.find(node->getSymbol());
+    if (slot_iter != _mSlots.end())
+      live[slot_iter->second] = true;
+    return;
+  }
+  for (auto *child : *node)
+    addReads(child, live);
+}
+
+bool DeadStoreEliminatingVisitor::removeStore(LSLExpression *store) {
+  ++mRemovedStores;
+  // `++foo` and friends don't have an rvalue
+  auto *rvalue = store->getChild(1);
+  if (rvalue && rvalue->getNodeType() == NODE_EXPRESSION && !expression_is_removable(rvalue)) {
+    // still need whatever evaluating it does, just not its result
+    rvalue = store->takeChild(1);
+    LSLASTNode::replaceNode(store, rvalue);
+    ((LSLExpression *) rvalue)->setResultNeeded(false);
+    return true;
+  }
+  auto *parent = store->getParent();
+  if (parent->getNodeSubType() == NODE_EXPRESSION_STATEMENT)
+    remove_statement((LSLStatement *) parent);
+  else
+    parent->removeChild(store);
+  return true;
+}
+
+bool DeadStoreEliminatingVisitor::removeInitializer(LSLDeclaration *decl) {
+  auto *sym = decl->getSymbol();
+  auto *initializer = decl->getInitializer();
+  if (!expression_is_removable(initializer)) {
+    // Splitting the declaration from its initializer only pays off
+    // if the declaration can go away entirely.
+    if (sym->getReferences() != 1 || sym->getAssignments() != 0)
+      return false;
+    decl->takeChild(1);
+    auto *expr_stmt = _mAllocator->newTracked<LSLExpressionStatement>(initializer);
+    expr_stmt->setLoc(initializer->getLoc());
+    initializer->setResultNeeded(false);
+    decl->getParent()->insertChild(expr_stmt, decl->getNext());
+  } else {
+    decl->setInitializer(nullptr);
+  }
+  ++mRemovedStores;
+  // the declaration might be all that's left now
+  if (auto *released = decl->mContext->released_symbols)
+    released->push_back(sym);
+  return true;
+}
+
+}
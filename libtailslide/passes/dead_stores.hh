@@ -0,0 +1,47 @@
+#ifndef TAILSLIDE_DEAD_STORES_HH
+#define TAILSLIDE_DEAD_STORES_HH
+
+#include <unordered_map>
+#include <vector>
+
+#include "../control_flow.hh"
+#include "../lslmini.hh"
+#include "../visitor.hh"
+
+namespace Tailslide {
+
+/// Removes assignments to locals and parameters whose value is never read afterward,
+/// found with a backward liveness analysis over the control flow graph of each function
+/// and event handler. If evaluating the assigned value might do something, the value
+/// is kept around as an expression statement of its own.
+/// Initializers of locals that are dead from the start get dropped the same way, as long
+/// as that doesn't mean splitting a declaration that's still needed in two.
+class DeadStoreEliminatingVisitor : public ASTVisitor {
+  public:
+    explicit DeadStoreEliminatingVisitor(ScriptAllocator *allocator) : _mAllocator(allocator) {}
+
+    virtual bool visit(LSLScript *script);
+
+    int mRemovedStores = 0;
+
+  protected:
+    // whether each tracked symbol might still be read, indexed by slot.
+    typedef std::vector<bool> LiveSet;
+
+    void eliminate(LSLASTNode *func);
+    bool eliminateOnce(LSLASTNode *func);
+    void trackSymbol(LSLSymbol *sym);
+    LSLSymbol *getKilledSymbol(LSLASTNode *node);
+    void transfer(LSLASTNode *node, LiveSet &live);
+    void addReads(LSLASTNode *node, LiveSet &live);
+    bool removeStore(LSLExpression *store);
+    bool removeInitializer(LSLDeclaration *decl);
+
+    ScriptAllocator *_mAllocator;
+    ControlFlowGraph _mGraph {};
+    std::unordered_map<LSLSymbol *, uint32_t> _mSlots {};
+};
+
+}
+
+#endif //TAILSLIDE_DEAD_STORES_HH
@@ -0,0 +1,362 @@
+#include <cmath>
+#include <vector>
+
+#include "inliner.hh"
+#include "side_effects.hh"
+
+namespace Tailslide {
+
+// Calls cost about as much as a handful of operators in either VM, anything that
+// ends up around that size is worth inlining wherever it's called. Functions with
+// only one call site go away entirely once inlined, so they can be a good deal bigger.
+static constexpr int MAX_INLINED_SIZE = 8;
+static constexpr int MAX_INLINED_SIZE_SINGLE_CALL = 32;
+
+static int expr_size(LSLASTNode *node) {
+  int size = node->getNodeType() == NODE_EXPRESSION ? 1 : 0;
+  for (auto *child : *node)
+    size += expr_size(child);
+  return size;
+}
+
+// Whether evaluating an argument once, many times or not at all all look the same.
+static bool is_pure_arg(LSLASTNode *node) {
+  if (node->getNodeType() == NODE_EXPRESSION) {
+    auto *expr = (LSLExpression *) node;
+    switch (expr->getNodeSubType()) {
+      case NODE_FUNCTION_EXPRESSION:
+      case NODE_PRINT_EXPRESSION:
+        return false;
+      default:
+        break;
+    }
+    if (operation_mutates(expr->getOperation()))
+      return false;
+  }
+  for (auto *child : *node) {
+    if (!is_pure_arg(child))
+      return false;
+  }
+  return true;
+}
+
+// Every name in the body has to mean the same thing at the call site,
+// a local there might shadow a global the body refers to.
+static bool resolves_same_at(LSLASTNode *node, LSLASTNode *call_site) {
+  if (node->getNodeType() == NODE_IDENTIFIER) {
+    auto *sym = node->getSymbol();
+    if (sym && sym->getSubType() != SYM_FUNCTION_PARAMETER
+        && call_site->lookupSymbol(((LSLIdentifier *) node)->getName(), sym->getSymbolType()) != sym)
+      return false;
+  }
+  for (auto *child : *node) {
+    if (!resolves_same_at(child, call_site))
+      return false;
+  }
+  return true;
+}
+
+// Whether this can be used as the operand of any operator without changing meaning
+static bool is_primary(LSLExpression *expr) {
+  switch (expr->getNodeSubType()) {
+    case NODE_LVALUE_EXPRESSION:
+    case NODE_FUNCTION_EXPRESSION:
+    case NODE_PARENTHESIS_EXPRESSION:
+    case NODE_LIST_EXPRESSION:
+    case NODE_VECTOR_EXPRESSION:
+    case NODE_QUATERNION_EXPRESSION:
+      return true;
+    case NODE_TYPECAST_EXPRESSION:
+      return is_primary((LSLExpression *) expr->getChild(0));
+    case NODE_CONSTANT_EXPRESSION: {
+      // `- -1` would be fine, but `--1` wouldn't.
+      auto *cv = expr->getConstantValue();
+      if (cv->getIType() == LST_INTEGER)
+        return ((LSLIntegerConstant *) cv)->getValue() >= 0;
+      if (cv->getIType() == LST_FLOATINGPOINT)
+        return !std::signbit(((LSLFloatConstant *) cv)->getValue());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// Whether a non-primary expression needs to be wrapped in parens to be a child of `parent`
+static bool needs_parens_under(LSLASTNode *parent) {
+  if (!parent || parent->getNodeType() != NODE_EXPRESSION)
+    return false;
+  switch (parent->getNodeSubType()) {
+    // these either bring their own parens or can't be confused about where their children end
+    case NODE_PARENTHESIS_EXPRESSION:
+    case NODE_TYPECAST_EXPRESSION:
+    case NODE_PRINT_EXPRESSION:
+    case NODE_LIST_EXPRESSION:
+      return false;
+    default:
+      return true;
+  }
+}
+
+static LSLParamList *get_params(LSLGlobalFunction *func) {
+  return func->getSymbol()->getFunctionDecl();
+}
+
+static LSLExpression *get_body_expr(LSLStatement *body_stmt) {
+  if (body_stmt->getNodeSubType() == NODE_RETURN_STATEMENT)
+    return ((LSLReturnStatement *) body_stmt)->getExpr();
+  return ((LSLExpressionStatement *) body_stmt)->getExpr();
+}
+
+bool FunctionInliningVisitor::visit(LSLScript *script) {
+  for (auto *child : *script->getGlobals()) {
+    if (child->getNodeType() == NODE_GLOBAL_FUNCTION)
+      collectCandidate((LSLGlobalFunction *) child);
+  }
+  if (_mCandidates.empty())
+    return false;
+  return true;
+}
+
+void FunctionInliningVisitor::collectCandidate(LSLGlobalFunction *func) {
+  auto *sym = func->getSymbol();
+  auto *script = (LSLScript *) func->getRoot();
+  // Inlining a recursive function would never end, and jumps can't go in an expression.
+  if (!sym || sym->getHasJumps() || script->getCallGraph().isRecursive(sym))
+    return;
+
+  auto *body = func->getStatements();
+  if (!body || body->getNodeSubType() != NODE_COMPOUND_STATEMENT || body->getNumChildren() != 1)
+    return;
+  auto *body_stmt = (LSLStatement *) body->getChild(0);
+  if (sym->getIType() == LST_NULL) {
+    if (body_stmt->getNodeSubType() != NODE_EXPRESSION_STATEMENT)
+      return;
+  } else {
+    if (!sym->getAllPathsReturn() || body_stmt->getNodeSubType() != NODE_RETURN_STATEMENT)
+      return;
+  }
+  if (!get_body_expr(body_stmt))
+    return;
+
+  // parameters get replaced with the arguments themselves, so they can't be assigned to.
+  for (auto *param : *get_params(func)) {
+    if (!param->getSymbol() || param->getSymbol()->getAssignments())
+      return;
+  }
+  _mCandidates[sym] = {func, body_stmt};
+}
+
+bool FunctionInliningVisitor::visit(LSLFunctionExpression *func_expr) {
+  // Do the arguments first, inlining calls within them may leave them pure.
+  visitChildren(func_expr);
+
+  auto candidate_iter = _mCandidates.find(func_expr->getSymbol());
+  if (candidate_iter == _mCandidates.end())
+    return false;
+  auto &candidate = candidate_iter->second;
+  if (!shouldInline(func_expr, candidate))
+    return false;
+
+  auto *inlined_expr = buildInlinedExpr(func_expr, candidate);
+  LSLASTNode::replaceNode(func_expr, inlined_expr);
+  ++mInlinedCalls;
+  // the body may have had calls of its own worth inlining
+  inlined_expr->visit(this);
+  return false;
+}
+
+bool FunctionInliningVisitor::shouldInline(LSLFunctionExpression *func_expr, InlineCandidate &candidate) {
+  auto *sym = func_expr->getSymbol();
+  auto *body_expr = get_body_expr(candidate.body_stmt);
+  // A function that doesn't return anything has nothing to substitute into an expression,
+  // it has to be the whole statement.
+  if (sym->getIType() == LST_NULL) {
+    auto *parent = func_expr->getParent();
+    if (!parent || parent->getNodeSubType() != NODE_EXPRESSION_STATEMENT)
+      return false;
+  }
+
+  // The body is evaluated where the arguments would have been. If it assigns to a global
+  // or calls a function that might, reading that global in an argument could come out
+  // differently depending on where in the body the parameter was read.
+  SideEffects body_effects;
+  body_effects.collect(body_expr);
+  std::vector<LSLSymbol *> arg_reads;
+  auto *params = get_params(candidate.func);
+  auto *args = func_expr->getArguments();
+  int inlined_size = expr_size(body_expr);
+  auto arg_iter = args->begin();
+  for (auto *param : *params) {
+    if (arg_iter == args->end())
+      return false;
+    auto *arg = *arg_iter;
+    ++arg_iter;
+
+    if (!is_pure_arg(arg))
+      return false;
+    arg_reads.clear();
+    collect_read_symbols(arg, arg_reads);
+    if (body_effects.clobbers(arg_reads))
+      return false;
+
+    int uses = 0;
+    for (auto *use = param->getSymbol()->getFirstUse(); use; use = use->getNextUse()) {
+      // the parameter's own declaration
+      if (use == param)
+        continue;
+      ++uses;
+      // `param.x` only has an equivalent if the argument is a plain variable,
+      // builtin constants like `ZERO_VECTOR` can't have members accessed.
+      auto *lvalue = (LSLLValueExpression *) use->getParent();
+      if (lvalue->getMember()) {
+        if (arg->getNodeSubType() != NODE_LVALUE_EXPRESSION || ((LSLLValueExpression *) arg)->getMember())
+          return false;
+        auto *arg_sym = arg->getSymbol();
+        if (!arg_sym || arg_sym->getSubType() == SYM_BUILTIN)
+          return false;
+      }
+    }
+    // each use gets its own copy of the argument in place of the parameter
+    inlined_size += uses * (expr_size(arg) - 1);
+  }
+  if (arg_iter != args->end())
+    return false;
+
+  // only the declaration and this call
+  int size_limit = sym->getReferences() == 2 ? MAX_INLINED_SIZE_SINGLE_CALL : MAX_INLINED_SIZE;
+  if (inlined_size > size_limit)
+    return false;
+  return resolves_same_at(body_expr, func_expr);
+}
+
+LSLExpression *FunctionInliningVisitor::buildInlinedExpr(LSLFunctionExpression *func_expr, InlineCandidate &candidate) {
+  _mArgs.clear();
+  auto arg_iter = func_expr->getArguments()->begin();
+  for (auto *param : *get_params(candidate.func)) {
+    _mArgs[param->getSymbol()] = *arg_iter;
+    ++arg_iter;
+  }
+
+  auto *inlined_expr = cloneExpr(get_body_expr(candidate.body_stmt));
+  _mArgs.clear();
+
+  // `return` does the same implicit conversions that assignment does
+  auto *ret_type = func_expr->getSymbol()->getType();
+  // Typecasts get whatever parens they need when they're printed, no need to add our own.
+  if (ret_type->getIType() != LST_NULL && inlined_expr->getIType() != ret_type->getIType())
+    inlined_expr = _mAllocator->newTracked<LSLTypecastExpression>(ret_type, inlined_expr);
+
+  auto *parent = func_expr->getParent();
+  if (!is_primary(inlined_expr) && needs_parens_under(parent)) {
+    auto *parens_expr = _mAllocator->newTracked<LSLParenthesisExpression>(inlined_expr);
+    parens_expr->setType(inlined_expr->getType());
+    inlined_expr = parens_expr;
+  }
+  inlined_expr->setLoc(func_expr->getLoc());
+  return inlined_expr;
+}
+
+LSLExpression *FunctionInliningVisitor::substituteParam(LSLLValueExpression *lvalue, LSLExpression *arg) {
+  LSLExpression *new_expr;
+  if (auto *member = lvalue->getMember()) {
+    auto *arg_lvalue = (LSLLValueExpression *) arg;
+    auto *new_lvalue = _mAllocator->newTracked<LSLLValueExpression>(
+        arg_lvalue->getIdentifier()->clone(), member->clone());
+    new_lvalue->setLoc(arg_lvalue->getLoc());
+    new_lvalue->setType(lvalue->getType());
+    new_lvalue->setIsFoldable(arg_lvalue->getIsFoldable());
+    new_lvalue->setInGlobalContext(arg_lvalue->getInGlobalContext());
+    return new_lvalue;
+  }
+
+  new_expr = cloneExpr(arg);
+  // the implicit conversion that would have happened when passing the argument
+  auto *param_type = lvalue->getType();
+  bool needs_cast = new_expr->getIType() != param_type->getIType();
+  if (!is_primary(new_expr) && !needs_cast && needs_parens_under(lvalue->getParent())) {
+    auto *parens_expr = _mAllocator->newTracked<LSLParenthesisExpression>(new_expr);
+    parens_expr->setType(new_expr->getType());
+    new_expr = parens_expr;
+  }
+  if (needs_cast)
+    new_expr = _mAllocator->newTracked<LSLTypecastExpression>(param_type, new_expr);
+  return new_expr;
+}
+
+LSLExpression *FunctionInliningVisitor::cloneExpr(LSLExpression *expr) {
+  LSLExpression *new_expr;
+  switch (expr->getNodeSubType()) {
+    case NODE_CONSTANT_EXPRESSION:
+      new_expr = _mAllocator->newTracked<LSLConstantExpression>(
+          ((LSLConstant *) expr->getChild(0))->copy(_mAllocator));
+      break;
+    case NODE_LVALUE_EXPRESSION: {
+      auto *lvalue = (LSLLValueExpression *) expr;
+      auto arg_iter = _mArgs.find(lvalue->getSymbol());
+      if (arg_iter != _mArgs.end())
+        return substituteParam(lvalue, arg_iter->second);
+      return lvalue->clone();
+    }
+    case NODE_FUNCTION_EXPRESSION: {
+      auto *func_expr = (LSLFunctionExpression *) expr;
+      auto *new_args = _mAllocator->newTracked<LSLASTNodeList<LSLExpression>>();
+      for (auto *arg : *func_expr->getArguments())
+        new_args->pushChild(cloneExpr(arg));
+      new_expr = _mAllocator->newTracked<LSLFunctionExpression>(func_expr->getIdentifier()->clone(), new_args);
+      break;
+    }
+    case NODE_BINARY_EXPRESSION: {
+      auto *bin_expr = (LSLBinaryExpression *) expr;
+      new_expr = _mAllocator->newTracked<LSLBinaryExpression>(
+          cloneExpr(bin_expr->getLHS()), bin_expr->getOperation(), cloneExpr(bin_expr->getRHS()));
+      break;
+    }
+    case NODE_UNARY_EXPRESSION: {
+      auto *unary_expr = (LSLUnaryExpression *) expr;
+      new_expr = _mAllocator->newTracked<LSLUnaryExpression>(
+          cloneExpr(unary_expr->getChildExpr()), unary_expr->getOperation());
+      break;
+    }
+    case NODE_TYPECAST_EXPRESSION:
+      new_expr = _mAllocator->newTracked<LSLTypecastExpression>(
+          expr->getType(), cloneExpr(((LSLTypecastExpression *) expr)->getChildExpr()));
+      break;
+    case NODE_PARENTHESIS_EXPRESSION:
+      new_expr = _mAllocator->newTracked<LSLParenthesisExpression>(
+          cloneExpr(((LSLParenthesisExpression *) expr)->getChildExpr()));
+      break;
+    case NODE_PRINT_EXPRESSION:
+      new_expr = _mAllocator->newTracked<LSLPrintExpression>(
+          cloneExpr(((LSLPrintExpression *) expr)->getChildExpr()));
+      break;
+    case NODE_VECTOR_EXPRESSION: {
+      auto *vec_expr = (LSLVectorExpression *) expr;
+      new_expr = _mAllocator->newTracked<LSLVectorExpression>(
+          cloneExpr(vec_expr->getX()), cloneExpr(vec_expr->getY()), cloneExpr(vec_expr->getZ()));
+      break;
+    }
+    case NODE_QUATERNION_EXPRESSION: {
+      auto *quat_expr = (LSLQuaternionExpression *) expr;
+      new_expr = _mAllocator->newTracked<LSLQuaternionExpression>(
+          cloneExpr(quat_expr->getX()), cloneExpr(quat_expr->getY()),
+          cloneExpr(quat_expr->getZ()), cloneExpr(quat_expr->getS()));
+      break;
+    }
+    case NODE_LIST_EXPRESSION: {
+      new_expr = _mAllocator->newTracked<LSLListExpression>(nullptr);
+      for (auto *elem : *(LSLListExpression *) expr)
+        new_expr->pushChild(cloneExpr(elem));
+      break;
+    }
+    default:
+      // only desugaring makes anything else, and that happens long after optimization.
+      assert(0);
+      return nullptr;
+  }
+  new_expr->setType(expr->getType());
+  new_expr->setLoc(expr->getLoc());
+  return new_expr;
+}
+
+}
@@ -0,0 +1,46 @@
+#ifndef TAILSLIDE_INLINER_HH
+#define TAILSLIDE_INLINER_HH
+
+#include <unordered_map>
+
+#include "../lslmini.hh"
+#include "../visitor.hh"
+
+namespace Tailslide {
+
+/// Replaces calls to small functions with a copy of the function's body.
+/// Only functions whose whole body is a single `return <expr>;`, or a single expression
+/// statement if they don't return anything, are candidates. Arguments get substituted
+/// for the parameters directly, so they must be free of side effects. Inlined copies
+/// don't have constant values yet, `propagateValues()` needs to be run again after.
+class FunctionInliningVisitor : public ASTVisitor {
+  public:
+    explicit FunctionInliningVisitor(ScriptAllocator *allocator) : _mAllocator(allocator) {}
+
+    virtual bool visit(LSLScript *script);
+    virtual bool visit(LSLFunctionExpression *func_expr);
+
+    int mInlinedCalls = 0;
+
+  protected:
+    struct InlineCandidate {
+      LSLGlobalFunction *func;
+      // either a return or an expression statement
+      LSLStatement *body_stmt;
+    };
+
+    void collectCandidate(LSLGlobalFunction *func);
+    bool shouldInline(LSLFunctionExpression *func_expr, InlineCandidate &candidate);
+    LSLExpression *buildInlinedExpr(LSLFunctionExpression *func_expr, InlineCandidate &candidate);
+    LSLExpression *cloneExpr(LSLExpression *expr);
+    LSLExpression *substituteParam(LSLLValueExpression *lvalue, LSLExpression *arg);
+
+    ScriptAllocator *_mAllocator;
+    std::unordered_map<LSLSymbol *, InlineCandidate> _mCandidates {};
+    // parameters of the function being inlined and the arguments they're getting
+    std::unordered_map<LSLSymbol *, LSLExpression *> _mArgs {};
+};
+
+}
+
+#endif //TAILSLIDE_INLINER_HH
@@ -0,0 +1,169 @@
+#include <cstring>
+
+#include "loop_invariant_motion.hh"
+#include "values.hh"
+
+namespace Tailslide {
+
+// Anything cheaper isn't worth the read of a local it'd be replaced with
+static const int MIN_HOISTED_COST = 3;
+
+static bool exprs_identical(LSLASTNode *a, LSLASTNode *b) {
+  while (a->getNodeSubType() == NODE_PARENTHESIS_EXPRESSION)
+    a = a->getChild(0);
+  while (b->getNodeSubType() == NODE_PARENTHESIS_EXPRESSION)
+    b = b->getChild(0);
+  if (a->getNodeType() != b->getNodeType() || a->getNodeSubType() != b->getNodeSubType())
+    return false;
+  if (a->getIType() != b->getIType())
+    return false;
+  switch (a->getNodeType()) {
+    case NODE_IDENTIFIER:
+      // member names like `x` don't have a symbol
+      if (a->getSymbol() != b->getSymbol())
+        return false;
+      return a->getSymbol() || !strcmp(((LSLIdentifier *) a)->getName(), ((LSLIdentifier *) b)->getName());
+    case NODE_CONSTANT:
+      return constants_identical((LSLConstant *) a, (LSLConstant *) b);
+    case NODE_EXPRESSION:
+      if (((LSLExpression *) a)->getOperation() != ((LSLExpression *) b)->getOperation())
+        return false;
+      break;
+    default:
+      break;
+  }
+  auto *b_child = b->getChild(0);
+  for (auto *a_child : *a) {
+    if (!b_child || !exprs_identical(a_child, b_child))
+      return false;
+    b_child = b_child->getNext();
+  }
+  return b_child == nullptr;
+}
+
+// the local might be shadowed by something else with the same name where it'd be read
+static bool can_read_local(LSLSymbol *sym, LSLASTNode *node) {
+  return node->lookupSymbol(sym->getName(), SYM_VARIABLE) == sym;
+}
+
+bool LoopInvariantHoistingVisitor::visit(LSLGlobalFunction *glob_func) {
+  _mFunc = glob_func;
+  return true;
+}
+
+bool LoopInvariantHoistingVisitor::visit(LSLEventHandler *handler) {
+  _mFunc = handler;
+  return true;
+}
+
+bool LoopInvariantHoistingVisitor::visit(LSLWhileStatement *while_stmt) {
+  hoistFrom(while_stmt);
+  return true;
+}
+
+bool LoopInvariantHoistingVisitor::visit(LSLDoStatement *do_stmt) {
+  hoistFrom(do_stmt);
+  return true;
+}
+
+bool LoopInvariantHoistingVisitor::visit(LSLForStatement *for_stmt) {
+  hoistFrom(for_stmt);
+  return true;
+}
+
+void LoopInvariantHoistingVisitor::hoistFrom(LSLStatement *loop_stmt) {
+  // The new local has to be declared right in front of the loop, a loop that's
+  // the body of an `if` or another loop has nowhere to put it.
+  auto *compound_stmt = loop_stmt->getParent();
+  if (!compound_stmt || compound_stmt->getNodeSubType() != NODE_COMPOUND_STATEMENT)
+    return;
+  // jumping into the loop would skip past the new local's declaration
+  if (can_be_jumped_into(loop_stmt))
+    return;
+
+  SideEffects effects;
+  effects.collect(loop_stmt);
+  std::vector<LSLExpression *> invariants;
+  for (auto *child : *loop_stmt) {
+    // the init expressions of a `for` only run once anyway
+    if (loop_stmt->getNodeSubType() == NODE_FOR_STATEMENT && child == ((LSLForStatement *) loop_stmt)->getInitExprs())
+      continue;
+    collectInvariants(child, effects, invariants);
+  }
+
+  // identical expressions share a local
+  std::vector<bool> handled(invariants.size(), false);
+  for (size_t i = 0; i < invariants.size(); ++i) {
+    if (handled[i])
+      continue;
+    auto *sym = findExistingLocal(invariants[i], loop_stmt);
+    if (sym && can_read_local(sym, invariants[i]))
+      LSLASTNode::replaceNode(invariants[i], _mSynthesizer.newRead(sym, invariants[i]));
+    else
+      sym = _mSynthesizer.moveIntoLocal(invariants[i], compound_stmt, loop_stmt, _mFunc);
+    for (size_t j = i + 1; j < invariants.size(); ++j) {
+      if (!handled[j] && can_read_local(sym, invariants[j])
+          && exprs_identical(((LSLDeclaration *) sym->getVarDecl())->getInitializer(), invariants[j])) {
+        LSLASTNode::replaceNode(invariants[j], _mSynthesizer.newRead(sym, invariants[j]));
+        handled[j] = true;
+      }
+    }
+    ++mHoistedExprs;
+  }
+}
+
+/// Find a local declared in front of the loop that's initialized with `expr` and still
+/// holds the same result by the time the loop starts.
+LSLSymbol *LoopInvariantHoistingVisitor::findExistingLocal(LSLExpression *expr, LSLStatement *loop_stmt) {
+  std::vector<LSLSymbol *> reads;
+  collect_read_symbols(expr, reads);
+  SideEffects between;
+  for (auto *stmt = loop_stmt->getPrev(); stmt; stmt = stmt->getPrev()) {
+    // jumping to a label in between would skip past the local's declaration
+    if (can_be_jumped_into(stmt))
+      return nullptr;
+    if (stmt->getNodeSubType() == NODE_DECLARATION) {
+      auto *sym = stmt->getSymbol();
+      auto *initializer = ((LSLDeclaration *) stmt)->getInitializer();
+      if (initializer && sym->getAssignments() == 0 && sym->getType() == expr->getType()
+          && !between.clobbers(reads) && exprs_identical(initializer, expr))
+        return sym;
+    }
+    between.collect(stmt);
+  }
+  return nullptr;
+}
+
+/// Find the biggest invariant expressions under `node` that are worth hoisting
+void LoopInvariantHoistingVisitor::collectInvariants(
+    LSLASTNode *node, const SideEffects &effects, std::vector<LSLExpression *> &invariants) {
+  if (node->getNodeType() == NODE_EXPRESSION) {
+    // it'll get folded into a constant, or it's already as cheap as reading a local.
+    if (node->getConstantValue())
+      return;
+    switch (node->getNodeSubType()) {
+      case NODE_LVALUE_EXPRESSION:
+        return;
+      case NODE_PARENTHESIS_EXPRESSION:
+      case NODE_LIST_EXPRESSION:
+        break;
+      default:
+        if (expression_cost(node) >= MIN_HOISTED_COST && expression_is_pure(node)) {
+          std::vector<LSLSymbol *> reads;
+          collect_read_symbols(node, reads);
+          if (!effects.clobbers(reads)) {
+            // parens go along with it
+            while (node->getParent()->getNodeSubType() == NODE_PARENTHESIS_EXPRESSION)
+              node = node->getParent();
+            invariants.push_back((LSLExpression *) node);
+            return;
+          }
+        }
+        break;
+    }
+  }
+  for (auto *child : *node)
+    collectInvariants(child, effects, invariants);
+}
+
+}
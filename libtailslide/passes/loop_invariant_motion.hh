@@ -0,0 +1,44 @@
+#ifndef TAILSLIDE_LOOP_INVARIANT_MOTION_HH
+#define TAILSLIDE_LOOP_INVARIANT_MOTION_HH
+
+#include <vector>
+
+#include "../lslmini.hh"
+#include "../visitor.hh"
+#include "side_effects.hh"
+#include "synthesized_locals.hh"
+
+namespace Tailslide {
+
+/// Moves pure expressions that give the same result every time around a loop out in front
+/// of it, keeping the result in a new local that the loop reads from instead.
+/// An expression can move if nothing in the loop assigns to what it reads. The loop
+/// might not run at all, but pure expressions can't halt the script so that's fine.
+/// If a local declared in front of the loop already holds the result, the loop reads
+/// that instead of getting a new local that would just be a copy of it.
+class LoopInvariantHoistingVisitor : public ASTVisitor {
+  public:
+    explicit LoopInvariantHoistingVisitor(ScriptAllocator *allocator) : _mSynthesizer(allocator, "_licm") {}
+
+    virtual bool visit(LSLGlobalVariable *glob_var) { return false; }
+    virtual bool visit(LSLGlobalFunction *glob_func);
+    virtual bool visit(LSLEventHandler *handler);
+    virtual bool visit(LSLWhileStatement *while_stmt);
+    virtual bool visit(LSLDoStatement *do_stmt);
+    virtual bool visit(LSLForStatement *for_stmt);
+
+    int mHoistedExprs = 0;
+
+  protected:
+    void hoistFrom(LSLStatement *loop_stmt);
+    LSLSymbol *findExistingLocal(LSLExpression *expr, LSLStatement *loop_stmt);
+    void collectInvariants(LSLASTNode *node, const SideEffects &effects, std::vector<LSLExpression *> &invariants);
+
+    LocalSynthesizer _mSynthesizer;
+    // the function or event handler we're in
+    LSLASTNode *_mFunc = nullptr;
+};
+
+}
+
+#endif //TAILSLIDE_LOOP_INVARIANT_MOTION_HH
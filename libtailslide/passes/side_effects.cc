@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "side_effects.hh"
+
+namespace Tailslide {
+
+bool builtin_is_pure(LSLSymbol *sym) {
+  if (!sym || sym->getSubType() != SYM_BUILTIN || sym->getSymbolType() != SYM_FUNCTION)
+    return false;
+  return sym->hasBuiltinAttr(BUILTIN_ATTR_PURE);
+}
+
+bool builtin_has_effects(LSLSymbol *sym) {
+  if (!sym || sym->getSubType() != SYM_BUILTIN || sym->getSymbolType() != SYM_FUNCTION)
+    return true;
+  return sym->hasBuiltinAttr(BUILTIN_ATTR_WRITES_WORLD) || sym->hasBuiltinAttr(BUILTIN_ATTR_MAY_SLEEP);
+}
+
+// Dividing by zero is a math error that halts the script, so a division is only
+// safe to move around if we know the divisor is fine.
+static bool is_safe_divisor(LSLExpression *divisor) {
+  switch (divisor->getIType()) {
+    case LST_VECTOR:
+    case LST_QUATERNION:
+      return true;
+    default:;
+  }
+  auto *cv = divisor->getConstantValue();
+  if (!cv)
+    return false;
+  if (cv->getIType() == LST_INTEGER) {
+    // `-2147483648 / -1` overflows
+    auto int_val = ((LSLIntegerConstant *) cv)->getValue();
+    return int_val != 0 && int_val != -1;
+  }
+  if (cv->getIType() == LST_FLOATINGPOINT) {
+    auto float_val = ((LSLFloatConstant *) cv)->getValue();
+    return float_val != 0.0 && std::isfinite(float_val);
+  }
+  return false;
+}
+
+static bool get_float_arg(LSLASTNode *arg, double &value) {
+  // might be short on arguments if the script has errors
+  auto *cv = arg ? arg->getConstantValue() : nullptr;
+  if (!cv)
+    return false;
+  if (cv->getIType() == LST_INTEGER)
+    value = ((LSLIntegerConstant *) cv)->getValue();
+  else if (cv->getIType() == LST_FLOATINGPOINT)
+    value = ((LSLFloatConstant *) cv)->getValue();
+  else
+    return false;
+  return true;
+}
+
+// A few math builtins halt the script with a math error when the result isn't
+// a real number, so calls to them are only safe to move around if we know the
+// arguments are fine.
+static bool has_safe_math_args(LSLASTNode *call) {
+  const char *name = call->getSymbol()->getName();
+  auto *args = ((LSLFunctionExpression *) call)->getArguments();
+  double base, exponent;
+  if (!strcmp(name, "llSqrt"))
+    return get_float_arg(args->getChild(0), base) && base >= 0.0;
+  if (!strcmp(name, "llPow")) {
+    return get_float_arg(args->getChild(0), base) && get_float_arg(args->getChild(1), exponent)
+        && std::isfinite((float) pow(base, exponent));
+  }
+  return true;
+}
+
+bool operation_is_pure(LSLASTNode *node) {
+  switch (node->getNodeSubType()) {
+    case NODE_CONSTANT_EXPRESSION:
+    case NODE_LVALUE_EXPRESSION:
+    case NODE_TYPECAST_EXPRESSION:
+    case NODE_BOOL_CONVERSION_EXPRESSION:
+    case NODE_PARENTHESIS_EXPRESSION:
+    case NODE_VECTOR_EXPRESSION:
+    case NODE_QUATERNION_EXPRESSION:
+    case NODE_LIST_EXPRESSION:
+      return true;
+    case NODE_FUNCTION_EXPRESSION:
+      return builtin_is_pure(node->getSymbol()) && has_safe_math_args(node);
+    case NODE_BINARY_EXPRESSION: {
+      auto *expr = (LSLBinaryExpression *) node;
+      auto op = expr->getOperation();
+      if (operation_mutates(op))
+        return false;
+      return (op != OP_DIV && op != OP_MOD) || is_safe_divisor(expr->getRHS());
+    }
+    case NODE_UNARY_EXPRESSION:
+      return !operation_mutates(((LSLExpression *) node)->getOperation());
+    default:
+      return false;
+  }
+}
+
+// Whether dropping the expression node wouldn't make a difference, other than its result
+static bool operation_is_removable(LSLASTNode *node) {
+  if (node->getNodeSubType() == NODE_FUNCTION_EXPRESSION)
+    return !builtin_has_effects(node->getSymbol()) && has_safe_math_args(node);
+  return operation_is_pure(node);
+}
+
+static bool all_operations(LSLASTNode *node, bool (*operation_pred)(LSLASTNode *)) {
+  if (!operation_pred(node))
+    return false;
+  // their children are just identifiers or constants
+  switch (node->getNodeSubType()) {
+    case NODE_CONSTANT_EXPRESSION:
+    case NODE_LVALUE_EXPRESSION:
+      return true;
+    default:;
+  }
+  if (node->getNodeSubType() == NODE_FUNCTION_EXPRESSION)
+    node = ((LSLFunctionExpression *) node)->getArguments();
+  for (auto *child : *node) {
+    if (!all_operations(child, operation_pred))
+      return false;
+  }
+  return true;
+}
+
+bool expression_is_pure(LSLASTNode *node) {
+  return all_operations(node, operation_is_pure);
+}
+
+bool expression_is_removable(LSLASTNode *node) {
+  return all_operations(node, operation_is_removable);
+}
+
+static void add_write(std::vector<LSLSymbol *> &writes, LSLSymbol *sym) {
+  if (sym && std::find(writes.begin(), writes.end(), sym) == writes.end())
+    writes.push_back(sym);
+}
+
+void SideEffects::collect(LSLASTNode *node) {
+  if (node->getNodeSubType() == NODE_DECLARATION) {
+    // a local declared inside a loop gets a fresh value every time around
+    add_write(writes, node->getSymbol());
+  } else if (node->getNodeType() == NODE_EXPRESSION) {
+    auto *expr = (LSLExpression *) node;
+    if (operation_mutates(expr->getOperation())) {
+      add_write(writes, expr->getChild(0)->getSymbol());
+    } else if (expr->getNodeSubType() == NODE_FUNCTION_EXPRESSION) {
+      auto *sym = expr->getSymbol();
+      if (sym && sym->getSubType() != SYM_BUILTIN)
+        calls_functions = true;
+    }
+  }
+  for (auto *child : *node)
+    collect(child);
+}
+
+bool SideEffects::clobbers(const std::vector<LSLSymbol *> &reads) const {
+  for (auto *sym : reads) {
+    if (calls_functions && sym->getSubType() == SYM_GLOBAL)
+      return true;
+    if (std::find(writes.begin(), writes.end(), sym) != writes.end())
+      return true;
+  }
+  return false;
+}
+
+void collect_read_symbols(LSLASTNode *node, std::vector<LSLSymbol *> &reads) {
+  if (node->getNodeSubType() == NODE_LVALUE_EXPRESSION) {
+    auto *sym = node->getSymbol();
+    if (sym && sym->getSubType() != SYM_BUILTIN && std::find(reads.begin(), reads.end(), sym) == reads.end())
+      reads.push_back(sym);
+    return;
+  }
+  for (auto *child : *node)
+    collect_read_symbols(child, reads);
+}
+
+}
@@ -0,0 +1,48 @@
+#ifndef TAILSLIDE_SIDE_EFFECTS_HH
+#define TAILSLIDE_SIDE_EFFECTS_HH
+
+#include <vector>
+
+#include "../lslmini.hh"
+
+namespace Tailslide {
+
+/// Whether a call to this builtin function has no effects, doesn't look at anything
+/// but its arguments and always gives the same result for the same arguments.
+bool builtin_is_pure(LSLSymbol *sym);
+
+/// Whether calling this function might change anything or take a while to return.
+/// Anything that isn't a builtin function might.
+bool builtin_has_effects(LSLSymbol *sym);
+
+/// Whether the expression node itself is pure, not counting anything under it
+bool operation_is_pure(LSLASTNode *node);
+
+/// Whether evaluating the expression can't change or observe anything other than the
+/// variables it reads. It also has to be impossible for it to halt the script, so it
+/// may be evaluated earlier or fewer times than it otherwise would have been.
+bool expression_is_pure(LSLASTNode *node);
+
+/// Whether evaluating the expression only computes its result, so it doesn't need
+/// evaluating at all if the result isn't needed. Unlike a pure expression, the result
+/// may depend on the state of the world.
+bool expression_is_removable(LSLASTNode *node);
+
+/// Everything evaluating a node might change that a pure expression could observe
+struct SideEffects {
+  // variables assigned to or declared somewhere under the node
+  std::vector<LSLSymbol *> writes;
+  // calls a user-defined function, which could assign to any global
+  bool calls_functions = false;
+
+  void collect(LSLASTNode *node);
+  /// Whether a pure expression reading `reads` might give a different result afterward
+  bool clobbers(const std::vector<LSLSymbol *> &reads) const;
+};
+
+/// Adds any variables read under the node to `reads`, builtin constants aren't included.
+void collect_read_symbols(LSLASTNode *node, std::vector<LSLSymbol *> &reads);
+
+}
+
+#endif //TAILSLIDE_SIDE_EFFECTS_HH
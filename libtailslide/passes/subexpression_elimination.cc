@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <cstring>
+
+#include "subexpression_elimination.hh"
+
+namespace Tailslide {
+
+// Expressions cheaper than this never make up for the local they'd need
+static const int MIN_ELIMINATED_COST = 3;
+
+template<typename T>
+static void append_bytes(std::string &key, const T &val) {
+  key.append((const char *) &val, sizeof(T));
+}
+
+// Enough to tell any two constants of the same type apart
+static bool append_constant_key(std::string &key, LSLConstant *cv) {
+  switch (cv->getIType()) {
+    case LST_INTEGER:
+      append_bytes(key, ((LSLIntegerConstant *) cv)->getValue());
+      return true;
+    case LST_FLOATINGPOINT:
+      append_bytes(key, ((LSLFloatConstant *) cv)->getValue());
+      return true;
+    case LST_STRING:
+    case LST_KEY: {
+      const char *str_val = ((LSLStringConstant *) cv)->getValue();
+      key.append(str_val, strlen(str_val) + 1);
+      return true;
+    }
+    case LST_VECTOR:
+      append_bytes(key, *((LSLVectorConstant *) cv)->getValue());
+      return true;
+    case LST_QUATERNION:
+      append_bytes(key, *((LSLQuaternionConstant *) cv)->getValue());
+      return true;
+    default:
+      // not worth comparing lists element by element
+      return false;
+  }
+}
+
+static bool is_within(LSLASTNode *node, LSLASTNode *ancestor) {
+  for (; node; node = node->getParent()) {
+    if (node == ancestor)
+      return true;
+  }
+  return false;
+}
+
+// the statement directly under `compound_stmt` that holds `node`
+static LSLASTNode *get_containing_statement(LSLASTNode *node, LSLASTNode *compound_stmt) {
+  while (node->getParent() != compound_stmt)
+    node = node->getParent();
+  return node;
+}
+
+// Expressions a statement evaluates exactly once, before anything else it does.
+static void get_leading_exprs(LSLASTNode *stmt, std::vector<LSLExpression *> &exprs) {
+  LSLASTNode *expr = nullptr;
+  switch (stmt->getNodeSubType()) {
+    case NODE_EXPRESSION_STATEMENT:
+      expr = ((LSLExpressionStatement *) stmt)->getExpr();
+      break;
+    case NODE_DECLARATION:
+      expr = ((LSLDeclaration *) stmt)->getInitializer();
+      break;
+    case NODE_RETURN_STATEMENT:
+      expr = ((LSLReturnStatement *) stmt)->getExpr();
+      break;
+    case NODE_IF_STATEMENT:
+      expr = ((LSLIfStatement *) stmt)->getCheckExpr();
+      break;
+    case NODE_FOR_STATEMENT:
+      // the condition gets evaluated every time around, but the init expressions only once.
+      for (auto *init_expr : *((LSLForStatement *) stmt)->getInitExprs())
+        exprs.push_back((LSLExpression *) init_expr);
+      return;
+    default:
+      return;
+  }
+  if (expr)
+    exprs.push_back((LSLExpression *) expr);
+}
+
+bool SubexpressionEliminatingVisitor::visit(LSLGlobalFunction *glob_func) {
+  _mFunc = glob_func;
+  return true;
+}
+
+bool SubexpressionEliminatingVisitor::visit(LSLEventHandler *handler) {
+  _mFunc = handler;
+  return true;
+}
+
+bool SubexpressionEliminatingVisitor::visit(LSLCompoundStatement *compound_stmt) {
+  _mOpenCandidates.clear();
+  _mCandidates.clear();
+  _mFinished.clear();
+
+  std::vector<LSLExpression *> leading_exprs;
+  for (auto *stmt : *compound_stmt) {
+    SideEffects effects;
+    effects.collect(stmt);
+    leading_exprs.clear();
+    get_leading_exprs(stmt, leading_exprs);
+    for (auto *expr : leading_exprs) {
+      bool pure;
+      numberExpr(expr, effects, pure);
+    }
+    closeClobbered(effects);
+    // Control can come from elsewhere past this point, so nothing computed before is
+    // known to still be around. The leading expressions all come before any label.
+    if (can_be_jumped_into(stmt)) {
+      while (!_mOpenCandidates.empty())
+        closeCandidate(_mOpenCandidates.begin()->first);
+    }
+  }
+  while (!_mOpenCandidates.empty())
+    closeCandidate(_mOpenCandidates.begin()->first);
+
+  // Bigger expressions go first, the expressions inside them only need their own
+  // local if they're still repeated after that.
+  std::stable_sort(_mFinished.begin(), _mFinished.end(), [](const Candidate &a, const Candidate &b) {
+    return a.cost > b.cost;
+  });
+  for (auto &candidate : _mFinished)
+    eliminate(compound_stmt, candidate);
+  _mFinished.clear();
+  // nested blocks get handled separately
+  return true;
+}
+
+uint32_t SubexpressionEliminatingVisitor::getValueNumber(const std::string &key) {
+  auto num_iter = _mValueNumbers.find(key);
+  if (num_iter != _mValueNumbers.end())
+    return num_iter->second;
+  // 0 is reserved for expressions that don't get numbered
+  auto value_num = (uint32_t)_mValueNumbers.size() + 1;
+  _mValueNumbers[key] = value_num;
+  return value_num;
+}
+
+/// Give `expr` a value number so that any structurally identical expression gets the same one,
+/// and record it as a use of a candidate if it's worth eliminating.
+uint32_t SubexpressionEliminatingVisitor::numberExpr(LSLExpression *expr, const SideEffects &effects, bool &pure) {
+  pure = operation_is_pure(expr);
+  std::string key;
+  append_bytes(key, expr->getNodeSubType());
+  append_bytes(key, expr->getIType());
+  switch (expr->getNodeSubType()) {
+    case NODE_PARENTHESIS_EXPRESSION:
+      return numberExpr((LSLExpression *) expr->getChild(0), effects, pure);
+    case NODE_CONSTANT_EXPRESSION: {
+      auto *cv = expr->getConstantValue();
+      if (!cv || !append_constant_key(key, cv)) {
+        pure = false;
+        return 0;
+      }
+      return getValueNumber(key);
+    }
+    case NODE_LVALUE_EXPRESSION: {
+      auto *sym = expr->getSymbol();
+      if (!sym) {
+        pure = false;
+        return 0;
+      }
+      append_bytes(key, sym);
+      if (auto *member = ((LSLLValueExpression *) expr)->getMember())
+        key += member->getName();
+      return getValueNumber(key);
+    }
+    case NODE_FUNCTION_EXPRESSION: {
+      append_bytes(key, expr->getSymbol());
+      for (auto *arg : *((LSLFunctionExpression *) expr)->getArguments()) {
+        bool arg_pure;
+        append_bytes(key, numberExpr((LSLExpression *) arg, effects, arg_pure));
+        pure = pure && arg_pure;
+      }
+      break;
+    }
+    default:
+      append_bytes(key, expr->getOperation());
+      for (auto *child : *expr) {
+        if (child->getNodeType() != NODE_EXPRESSION) {
+          pure = false;
+          continue;
+        }
+        bool child_pure;
+        append_bytes(key, numberExpr((LSLExpression *) child, effects, child_pure));
+        pure = pure && child_pure;
+      }
+      break;
+  }
+  if (!pure)
+    return 0;
+
+  uint32_t value_num = getValueNumber(key);
+  // list literals are cheap to build compared to the copying a local would mean
+  if (expr->getNodeSubType() == NODE_LIST_EXPRESSION)
+    return value_num;
+
+  auto open_iter = _mOpenCandidates.find(value_num);
+  if (open_iter != _mOpenCandidates.end()) {
+    auto &candidate = _mCandidates[open_iter->second];
+    if (!effects.clobbers(candidate.reads))
+      candidate.uses.push_back(expr);
+    return value_num;
+  }
+
+  int cost = expression_cost(expr);
+  if (cost < MIN_ELIMINATED_COST)
+    return value_num;
+  Candidate candidate {value_num, cost, {}, {}};
+  collect_read_symbols(expr, candidate.reads);
+  // the statement it's in changes something it reads, so when it's evaluated matters.
+  if (effects.clobbers(candidate.reads))
+    return value_num;
+  candidate.uses.push_back(expr);
+  _mOpenCandidates[value_num] = _mCandidates.size();
+  _mCandidates.push_back(std::move(candidate));
+  return value_num;
+}
+
+void SubexpressionEliminatingVisitor::closeCandidate(uint32_t value_num) {
+  auto open_iter = _mOpenCandidates.find(value_num);
+  assert(open_iter != _mOpenCandidates.end());
+  auto &candidate = _mCandidates[open_iter->second];
+  if (candidate.uses.size() > 1)
+    _mFinished.push_back(std::move(candidate));
+  _mOpenCandidates.erase(open_iter);
+}
+
+void SubexpressionEliminatingVisitor::closeClobbered(const SideEffects &effects) {
+  if (effects.writes.empty() && !effects.calls_functions)
+    return;
+  std::vector<uint32_t> clobbered;
+  for (auto &open : _mOpenCandidates) {
+    if (effects.clobbers(_mCandidates[open.second].reads))
+      clobbered.push_back(open.first);
+  }
+  for (auto value_num : clobbered)
+    closeCandidate(value_num);
+}
+
+void SubexpressionEliminatingVisitor::eliminate(LSLCompoundStatement *compound_stmt, Candidate &candidate) {
+  // Uses inside a bigger expression that was already eliminated are gone now,
+  // parens around a use go along with it.
+  std::vector<LSLExpression *> uses;
+  for (auto *use : candidate.uses) {
+    if (!is_within(use, compound_stmt))
+      continue;
+    while (use->getParent()->getNodeSubType() == NODE_PARENTHESIS_EXPRESSION)
+      use = (LSLExpression *) use->getParent();
+    uses.push_back(use);
+  }
+  if (uses.size() < 2)
+    return;
+
+  // The use that's evaluated first decides where the result gets computed. Moving a bigger
+  // expression into its own declaration may have moved uses in front of the others.
+  std::vector<LSLASTNode *> use_stmts;
+  for (auto *use : uses)
+    use_stmts.push_back(get_containing_statement(use, compound_stmt));
+  size_t first_idx = 0;
+  for (auto *stmt : *compound_stmt) {
+    auto stmt_iter = std::find(use_stmts.begin(), use_stmts.end(), stmt);
+    if (stmt_iter != use_stmts.end()) {
+      first_idx = stmt_iter - use_stmts.begin();
+      break;
+    }
+  }
+  auto *first_use = uses[first_idx];
+  auto *first_stmt = use_stmts[first_idx];
+  auto num_uses = (int)uses.size();
+  auto *type = first_use->getType();
+
+  // If the first use is already what a local gets initialized with, just read that local.
+  LSLSymbol *sym = nullptr;
+  if (first_stmt->getNodeSubType() == NODE_DECLARATION && first_use->getParent() == first_stmt) {
+    auto *decl_sym = first_stmt->getSymbol();
+    if (decl_sym->getType() == type && decl_sym->getAssignments() == 0)
+      sym = decl_sym;
+  }
+
+  if (sym) {
+    if ((num_uses - 1) * (candidate.cost - 1) <= 0)
+      return;
+  } else {
+    // every use still costs a read, and the new local costs a store
+    if ((num_uses - 1) * candidate.cost - num_uses - 2 <= 0)
+      return;
+    sym = _mSynthesizer.moveIntoLocal(first_use, compound_stmt, first_stmt, _mFunc);
+  }
+
+  for (size_t i = 0; i < uses.size(); ++i) {
+    if (i != first_idx)
+      LSLASTNode::replaceNode(uses[i], _mSynthesizer.newRead(sym, uses[i]));
+  }
+  ++mEliminatedExprs;
+}
+
+}
@@ -0,0 +1,58 @@
+#ifndef TAILSLIDE_SUBEXPRESSION_ELIMINATION_HH
+#define TAILSLIDE_SUBEXPRESSION_ELIMINATION_HH
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../lslmini.hh"
+#include "../visitor.hh"
+#include "side_effects.hh"
+#include "synthesized_locals.hh"
+
+namespace Tailslide {
+
+/// Evaluates pure expressions that get computed more than once in a row only once,
+/// keeping the result in a new local that the repeats read from instead.
+/// Expressions are hash-consed so structurally identical subtrees get the same value number.
+/// Each compound statement is handled on its own, looking at the expressions its statements
+/// unconditionally evaluate up front. A repeat only counts if nothing that could change
+/// the expression's result happened since the last time it was computed.
+class SubexpressionEliminatingVisitor : public ASTVisitor {
+  public:
+    explicit SubexpressionEliminatingVisitor(ScriptAllocator *allocator) : _mSynthesizer(allocator, "_cse") {}
+
+    virtual bool visit(LSLGlobalVariable *glob_var) { return false; }
+    virtual bool visit(LSLGlobalFunction *glob_func);
+    virtual bool visit(LSLEventHandler *handler);
+    virtual bool visit(LSLCompoundStatement *compound_stmt);
+
+    int mEliminatedExprs = 0;
+
+  protected:
+    struct Candidate {
+      uint32_t value_num;
+      int cost;
+      std::vector<LSLSymbol *> reads;
+      std::vector<LSLExpression *> uses;
+    };
+
+    uint32_t numberExpr(LSLExpression *expr, const SideEffects &effects, bool &pure);
+    uint32_t getValueNumber(const std::string &key);
+    void closeCandidate(uint32_t value_num);
+    void closeClobbered(const SideEffects &effects);
+    void eliminate(LSLCompoundStatement *compound_stmt, Candidate &candidate);
+
+    LocalSynthesizer _mSynthesizer;
+    // the function or event handler we're in
+    LSLASTNode *_mFunc = nullptr;
+    std::unordered_map<std::string, uint32_t> _mValueNumbers {};
+    // value numbers with a candidate still collecting uses, and the candidate's index
+    std::unordered_map<uint32_t, size_t> _mOpenCandidates {};
+    std::vector<Candidate> _mCandidates {};
+    std::vector<Candidate> _mFinished {};
+};
+
+}
+
+#endif //TAILSLIDE_SUBEXPRESSION_ELIMINATION_HH
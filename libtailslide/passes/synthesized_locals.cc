@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <cstring>
+
+#include "synthesized_locals.hh"
+
+namespace Tailslide {
+
+int expression_cost(LSLASTNode *node) {
+  int cost;
+  switch (node->getNodeSubType()) {
+    case NODE_PARENTHESIS_EXPRESSION:
+      cost = 0;
+      break;
+    case NODE_LVALUE_EXPRESSION:
+      return 1;
+    case NODE_FUNCTION_EXPRESSION:
+      return 4 + expression_cost(((LSLFunctionExpression *) node)->getArguments());
+    default:
+      cost = (node->getNodeType() == NODE_EXPRESSION) ? 1 : 0;
+      break;
+  }
+  for (auto *child : *node)
+    cost += expression_cost(child);
+  return cost;
+}
+
+bool can_be_jumped_into(LSLASTNode *stmt) {
+  if (stmt->getNodeSubType() == NODE_LABEL)
+    return true;
+  for (auto *child : *stmt) {
+    if (child->getNodeSubType() != NODE_COMPOUND_STATEMENT && can_be_jumped_into(child))
+      return true;
+  }
+  return false;
+}
+
+static bool name_used_within(LSLASTNode *node, const char *name) {
+  if (node->getNodeType() == NODE_IDENTIFIER && !strcmp(((LSLIdentifier *) node)->getName(), name))
+    return true;
+  for (auto *child : *node) {
+    if (name_used_within(child, name))
+      return true;
+  }
+  return false;
+}
+
+const char *LocalSynthesizer::newLocalName(LSLASTNode *scope, LSLASTNode *func) {
+  char name[32];
+  // Nothing visible from here can have the name, and nothing in the function either
+  // so we don't end up shadowing or being shadowed by anything.
+  for (;;) {
+    snprintf(name, sizeof(name), "%s%u", _mPrefix, _mNumLocals++);
+    if (!scope->lookupSymbol(name, SYM_ANY) && !name_used_within(func, name))
+      return _mAllocator->copyStr(name);
+  }
+}
+
+LSLLValueExpression *LocalSynthesizer::newRead(LSLSymbol *sym, LSLExpression *replacing) {
+  auto *id = _mAllocator->newTracked<LSLIdentifier>(sym->getType(), sym->getName());
+  id->setSymbol(sym);
+  auto *read = _mAllocator->newTracked<LSLLValueExpression>(id, nullptr);
+  read->setType(sym->getType());
+  read->setLoc(replacing->getLoc());
+  return read;
+}
+
+LSLSymbol *LocalSynthesizer::moveIntoLocal(
+    LSLExpression *expr, LSLASTNode *compound_stmt, LSLASTNode *before, LSLASTNode *func) {
+  auto *type = expr->getType();
+  const char *name = newLocalName(compound_stmt, func);
+  auto *decl_id = _mAllocator->newTracked<LSLIdentifier>(type, name);
+  auto *decl = _mAllocator->newTracked<LSLDeclaration>(decl_id, nullptr);
+  decl->setLoc(expr->getLoc());
+  auto *sym = _mAllocator->newTracked<LSLSymbol>(
+      name, type, SYM_VARIABLE, SYM_LOCAL, expr->getLoc(), nullptr, decl);
+  decl_id->setSymbol(sym);
+
+  LSLASTNode::replaceNode(expr, newRead(sym, expr));
+  // parens were only needed where it was used
+  LSLASTNode *initializer = expr;
+  while (initializer->getNodeSubType() == NODE_PARENTHESIS_EXPRESSION)
+    initializer = initializer->takeChild(0);
+  decl->setChild(1, initializer);
+  compound_stmt->insertChild(decl, before);
+  decl->defineSymbol(sym);
+  return sym;
+}
+
+}
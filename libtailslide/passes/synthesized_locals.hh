@@ -0,0 +1,37 @@
+#ifndef TAILSLIDE_SYNTHESIZED_LOCALS_HH
+#define TAILSLIDE_SYNTHESIZED_LOCALS_HH
+
+#include "../lslmini.hh"
+
+namespace Tailslide {
+
+/// Rough cost of evaluating an expression, a function call costs a lot more than
+/// any operator because of the call overhead.
+int expression_cost(LSLASTNode *node);
+
+/// Whether control could land somewhere inside `stmt` by jumping to a label from outside of it.
+/// Labels inside a nested block can only be jumped to from within that block.
+bool can_be_jumped_into(LSLASTNode *stmt);
+
+/// Moves expressions out into new locals for passes that want to keep a result around.
+class LocalSynthesizer {
+  public:
+    LocalSynthesizer(ScriptAllocator *allocator, const char *prefix) : _mAllocator(allocator), _mPrefix(prefix) {}
+
+    /// Move `expr` into the initializer of a new local declared right before `before`,
+    /// which must be directly under `compound_stmt`. A read of the new local takes its place.
+    /// `func` is the function or event handler all of this is in.
+    LSLSymbol *moveIntoLocal(LSLExpression *expr, LSLASTNode *compound_stmt, LSLASTNode *before, LSLASTNode *func);
+    LSLLValueExpression *newRead(LSLSymbol *sym, LSLExpression *replacing);
+
+  private:
+    const char *newLocalName(LSLASTNode *scope, LSLASTNode *func);
+
+    ScriptAllocator *_mAllocator;
+    const char *_mPrefix;
+    uint32_t _mNumLocals = 0;
+};
+
+}
+
+#endif //TAILSLIDE_SYNTHESIZED_LOCALS_HH
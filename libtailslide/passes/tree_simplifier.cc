@@ -1,4 +1,6 @@
 #include "tree_simplifier.hh"
+#include "../control_flow.hh"
+#include "side_effects.hh"
 
 namespace Tailslide {
 
@@ -10,9 +12,9 @@ bool TreeSimplifyingVisitor::visit(LSLDeclaration *decl_stmt) {
   if (!sym || sym->getReferences() != 1 || sym->getAssignments() != 0)
     return true;
   LSLASTNode *rvalue = decl_stmt->getInitializer();
-  // rvalue can't be reduced to a constant, don't know that we don't need
-  // the side-effects of evaluating the expression.
-  if(rvalue && !rvalue->getConstantValue())
+  // rvalue can't be reduced to a constant, we still need the side-effects
+  // of evaluating the expression if it has any.
+  if(rvalue && !rvalue->getConstantValue() && !expression_is_removable(rvalue))
     return true;
 
   ++mFoldedLevel;
@@ -153,6 +155,269 @@ bool TreeSimplifyingVisitor::visit(LSLConstantExpression *constant_expr) {
   return false;
 }
 
+// Whether a condition always goes the same way, and which way that is.
+static bool get_condition_truth(LSLExpression *cond, bool &truth) {
+  LSLConstant *cv = cond ? cond->getConstantValue() : nullptr;
+  if (!cv || cv->containsNaN())
+    return false;
+  switch (cv->getIType()) {
+    case LST_INTEGER:
+      truth = ((LSLIntegerConstant *) cv)->getValue() != 0;
+      return true;
+    case LST_FLOATINGPOINT:
+      truth = ((LSLFloatConstant *) cv)->getValue() != 0.0;
+      return true;
+    case LST_STRING:
+      truth = ((LSLStringConstant *) cv)->getValue()[0] != '\0';
+      return true;
+    case LST_VECTOR:
+      truth = *((LSLVectorConstant *) cv)->getValue() != Vector3();
+      return true;
+    case LST_QUATERNION:
+      truth = *((LSLQuaternionConstant *) cv)->getValue() != Quaternion();
+      return true;
+    case LST_LIST:
+      truth = ((LSLListConstant *) cv)->getLength() != 0;
+      return true;
+    default:
+      // keys are only true if they're valid UUIDs, leave those alone.
+      return false;
+  }
+}
+
+// Whether control can make it to the end of `stmt`, having entered it either
+// from the top or by jumping to a label somewhere inside it.
+static bool can_fall_through(LSLASTNode *stmt, bool &has_label) {
+  if (!stmt || stmt->getNodeType() != NODE_STATEMENT)
+    return true;
+  bool truth;
+  switch (stmt->getNodeSubType()) {
+    case NODE_LABEL:
+      has_label = true;
+      return true;
+    case NODE_RETURN_STATEMENT:
+    case NODE_STATE_STATEMENT:
+      return false;
+    case NODE_JUMP_STATEMENT:
+      return !jump_always_taken((LSLStatement *) stmt);
+    case NODE_COMPOUND_STATEMENT: {
+      bool reachable = true;
+      for (auto *child : *stmt) {
+        bool child_has_label = false;
+        bool completes = can_fall_through(child, child_has_label);
+        reachable = child_has_label ? completes : (reachable && completes);
+        has_label |= child_has_label;
+      }
+      return reachable;
+    }
+    case NODE_IF_STATEMENT: {
+      auto *if_stmt = (LSLIfStatement *) stmt;
+      bool true_completes = can_fall_through(if_stmt->getTrueBranch(), has_label);
+      bool false_completes = can_fall_through(if_stmt->getFalseBranch(), has_label);
+      return true_completes || false_completes;
+    }
+    // The only ways out of a loop whose condition is always true are the ones that
+    // leave the loop body without falling through it.
+    case NODE_WHILE_STATEMENT: {
+      auto *while_stmt = (LSLWhileStatement *) stmt;
+      can_fall_through(while_stmt->getBody(), has_label);
+      return !get_condition_truth(while_stmt->getCheckExpr(), truth) || !truth;
+    }
+    case NODE_FOR_STATEMENT: {
+      auto *for_stmt = (LSLForStatement *) stmt;
+      can_fall_through(for_stmt->getBody(), has_label);
+      return !get_condition_truth(for_stmt->getCheckExpr(), truth) || !truth;
+    }
+    case NODE_DO_STATEMENT: {
+      auto *do_stmt = (LSLDoStatement *) stmt;
+      bool body_completes = can_fall_through(do_stmt->getBody(), has_label);
+      return body_completes && (!get_condition_truth(do_stmt->getCheckExpr(), truth) || !truth);
+    }
+    default:
+      return true;
+  }
+}
+
+static bool is_within(LSLASTNode *node, LSLASTNode *ancestor) {
+  for (; node != nullptr; node = node->getParent()) {
+    if (node == ancestor)
+      return true;
+  }
+  return false;
+}
+
+// Whether any labels (and declarations, unless `labels_only`) within `region` are referred
+// to from outside of it. If not, nothing outside can tell whether the region exists, other
+// than by what it does when control passes through it.
+static bool has_outside_references(LSLASTNode *region, LSLASTNode *stmt, bool labels_only) {
+  auto sub_type = stmt->getNodeSubType();
+  if (sub_type == NODE_LABEL || (!labels_only && sub_type == NODE_DECLARATION)) {
+    for (auto *use = stmt->getSymbol()->getFirstUse(); use; use = use->getNextUse()) {
+      if (!is_within(use, region))
+        return true;
+    }
+  }
+  for (auto *child : *stmt) {
+    if (child->getNodeType() == NODE_STATEMENT && has_outside_references(region, child, labels_only))
+      return true;
+  }
+  return false;
+}
+
+// Mirrors how the compilers check that all code paths return a value
+static bool ends_in_return(LSLASTNode *stmt) {
+  switch (stmt->getNodeSubType()) {
+    case NODE_RETURN_STATEMENT:
+      return true;
+    case NODE_COMPOUND_STATEMENT: {
+      auto *last_child = stmt->getChild(stmt->getNumChildren() - 1);
+      return last_child && ends_in_return(last_child);
+    }
+    case NODE_IF_STATEMENT: {
+      auto *if_stmt = (LSLIfStatement *) stmt;
+      return if_stmt->getFalseBranch() && ends_in_return(if_stmt->getTrueBranch())
+          && ends_in_return(if_stmt->getFalseBranch());
+    }
+    default:
+      return false;
+  }
+}
+
+void remove_statement(LSLStatement *stmt) {
+  auto *parent = stmt->getParent();
+  if (parent->getNodeType() == NODE_STATEMENT && parent->getNodeSubType() == NODE_COMPOUND_STATEMENT) {
+    parent->removeChild(stmt);
+    return;
+  }
+  // `else` with nothing in it, can just drop the `else`.
+  if (parent->getNodeSubType() == NODE_IF_STATEMENT && ((LSLIfStatement *) parent)->getFalseBranch() == stmt) {
+    LSLASTNode::replaceNode(stmt, stmt->newNullNode());
+    return;
+  }
+  // bodies of `if`s and loops have to be _something_
+  auto *nop_stmt = stmt->mContext->allocator->newTracked<LSLNopStatement>();
+  nop_stmt->setLoc(stmt->getLoc());
+  LSLASTNode::replaceNode(stmt, nop_stmt);
+}
+
+bool TreeSimplifyingVisitor::visit(LSLCompoundStatement *compound_stmt) {
+  if (!mOpts.prune_dead_code)
+    return true;
+
+  std::vector<LSLASTNode *> dead_stmts;
+  bool reachable = true;
+  for (auto *child : *compound_stmt) {
+    // nothing needs the result, and working it out doesn't do anything else.
+    if (child->getNodeSubType() == NODE_EXPRESSION_STATEMENT
+        && expression_is_removable(((LSLExpressionStatement *) child)->getExpr())) {
+      dead_stmts.push_back(child);
+      continue;
+    }
+    bool has_label = false;
+    bool completes = can_fall_through(child, has_label);
+    // Nothing falls into this, the only way in would be jumping to a label inside it.
+    if (!reachable && (!has_label || !has_outside_references(child, child, true))) {
+      dead_stmts.push_back(child);
+      continue;
+    }
+    reachable = completes;
+  }
+
+  // Go backwards so uses of dead declarations are gone by the time we get to them.
+  // Declarations still used by something live, like after a label they were jumped
+  // over to get to, have to stay.
+  LSLASTNode *kept_return = nullptr;
+  for (auto iter = dead_stmts.rbegin(); iter != dead_stmts.rend(); ++iter) {
+    auto *stmt = *iter;
+    // Both compilers decide whether all code paths return by looking at the last statement,
+    // they don't know that whatever comes before it never falls through.
+    if (!stmt->getNext() && stmt->getNodeSubType() == NODE_RETURN_STATEMENT
+        && ((LSLReturnStatement *) stmt)->getExpr()) {
+      kept_return = stmt;
+      continue;
+    }
+    if (has_outside_references(stmt, stmt, false))
+      continue;
+    compound_stmt->removeChild(stmt);
+    ++mFoldedLevel;
+  }
+  // ...unless whatever's left before it would pass for returning on all paths anyway.
+  if (kept_return && kept_return->getPrev() && ends_in_return(kept_return->getPrev())) {
+    compound_stmt->removeChild(kept_return);
+    ++mFoldedLevel;
+  }
+  return true;
+}
+
+bool TreeSimplifyingVisitor::visit(LSLIfStatement *if_stmt) {
+  bool truth;
+  if (!mOpts.prune_dead_code || !get_condition_truth(if_stmt->getCheckExpr(), truth))
+    return true;
+
+  LSLStatement *taken = truth ? if_stmt->getTrueBranch() : if_stmt->getFalseBranch();
+  LSLStatement *not_taken = truth ? if_stmt->getFalseBranch() : if_stmt->getTrueBranch();
+  if (not_taken && has_outside_references(not_taken, not_taken, false))
+    return true;
+
+  ++mFoldedLevel;
+  if (taken) {
+    if_stmt->takeChild(truth ? 1 : 2);
+    LSLASTNode::replaceNode(if_stmt, taken);
+  } else {
+    remove_statement(if_stmt);
+  }
+  return true;
+}
+
+bool TreeSimplifyingVisitor::visit(LSLWhileStatement *while_stmt) {
+  bool truth;
+  if (!mOpts.prune_dead_code || !get_condition_truth(while_stmt->getCheckExpr(), truth) || truth)
+    return true;
+  if (has_outside_references(while_stmt, while_stmt, false))
+    return true;
+  ++mFoldedLevel;
+  remove_statement(while_stmt);
+  return true;
+}
+
+bool TreeSimplifyingVisitor::visit(LSLDoStatement *do_stmt) {
+  bool truth;
+  if (!mOpts.prune_dead_code || !get_condition_truth(do_stmt->getCheckExpr(), truth) || truth)
+    return true;
+  // body runs exactly once, the loop is just decoration.
+  ++mFoldedLevel;
+  auto *body = do_stmt->takeChild(0);
+  LSLASTNode::replaceNode(do_stmt, body);
+  return true;
+}
+
+bool TreeSimplifyingVisitor::visit(LSLForStatement *for_stmt) {
+  bool truth;
+  if (!mOpts.prune_dead_code || !get_condition_truth(for_stmt->getCheckExpr(), truth) || truth)
+    return true;
+  if (has_outside_references(for_stmt, for_stmt, false))
+    return true;
+
+  // the initializers still run before the condition gets checked
+  auto *init_exprs = for_stmt->getInitExprs();
+  auto *init_expr = init_exprs ? init_exprs->getChild(0) : nullptr;
+  if (!init_expr) {
+    ++mFoldedLevel;
+    remove_statement(for_stmt);
+    return true;
+  }
+  // Can only swap in a single statement for it, leave anything with more than one alone.
+  if (init_expr->getNext())
+    return true;
+
+  ++mFoldedLevel;
+  init_exprs->removeChild(init_expr);
+  auto *expr_stmt = for_stmt->mContext->allocator->newTracked<LSLExpressionStatement>((LSLExpression *) init_expr);
+  expr_stmt->setLoc(for_stmt->getLoc());
+  LSLASTNode::replaceNode(for_stmt, expr_stmt);
+  return true;
+}
+
 bool TreeSimplifyingVisitor::handleGlobal(LSLASTNode *glob) {
   // globals are either a single var or a single function.
   // and they both keep their identifier in the first child!
@@ -161,13 +426,19 @@ bool TreeSimplifyingVisitor::handleGlobal(LSLASTNode *glob) {
 
   LSLNodeType node_type = glob->getNodeType();
   auto *sym = id->getSymbol();
+  auto *script = (LSLScript *) glob->getRoot();
+  assert(script->getNodeType() == NODE_SCRIPT);
+
+  bool unused = sym->getReferences() == 1;
+  // Functions only called by each other (or by other dead functions) are just as unused
+  if (node_type == NODE_GLOBAL_FUNCTION && !script->getCallGraph().isReachable(sym))
+    unused = true;
 
   if (((node_type == NODE_GLOBAL_FUNCTION && mOpts.prune_unused_functions) ||
        (node_type == NODE_GLOBAL_VARIABLE && mOpts.prune_unused_globals))
-      && sym->getReferences() == 1) {
+      && unused) {
     ++mFoldedLevel;
     // these reside in the global scope, look for the root symbol table and the entry
-    LSLASTNode *script = glob->getRoot();
     script->getSymbolTable()->remove(sym);
     // remove the node itself
     glob->getParent()->removeChild(glob);
@@ -176,4 +447,37 @@ bool TreeSimplifyingVisitor::handleGlobal(LSLASTNode *glob) {
   return true;
 }
 
+void TreeSimplifyingVisitor::pruneReleasedSymbols(LSLScript *script, std::vector<LSLSymbol *> &released) {
+  while (!released.empty()) {
+    auto *sym = released.back();
+    released.pop_back();
+    // only the declaration itself left, it might be prunable now.
+    if (sym->getReferences() != 1)
+      continue;
+
+    LSLASTNode *decl = nullptr;
+    if (sym->getSymbolType() == SYM_VARIABLE) {
+      decl = sym->getVarDecl();
+    } else if (sym->getSymbolType() == SYM_FUNCTION && sym->getFunctionDecl()) {
+      decl = sym->getFunctionDecl()->getParent();
+    }
+    // may have been pruned already, or been part of something that was.
+    if (!decl || decl->getRoot() != script)
+      continue;
+
+    switch (decl->getNodeType()) {
+      case NODE_GLOBAL_VARIABLE:
+      case NODE_GLOBAL_FUNCTION:
+        handleGlobal(decl);
+        break;
+      case NODE_STATEMENT:
+        if (decl->getNodeSubType() == NODE_DECLARATION)
+          visit((LSLDeclaration *)decl);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
 }
@@ -11,11 +11,35 @@ struct OptimizationOptions {
     bool prune_unused_globals = false;
     bool prune_unused_functions = false;
     bool may_create_new_strs = false;
+    // track the values of locals that get assigned to through each function's control flow,
+    // so reads of them can be folded too. Only matters alongside `fold_constants`.
+    bool propagate_constants = false;
+    // drop branches that can never be taken, loops that never run and
+    // statements that control can never reach.
+    bool prune_dead_code = false;
+    // replace calls to functions whose body is a single expression with the expression itself.
+    bool inline_functions = false;
+    // compute repeated pure expressions once and keep the result in a local.
+    bool eliminate_common_subexprs = false;
+    // compute pure expressions that give the same result every time around a loop
+    // once before the loop, and keep the result in a local.
+    bool hoist_loop_invariants = false;
+    // drop assignments to locals and parameters that get overwritten or go out
+    // of scope before anything reads them.
+    bool prune_dead_stores = false;
+    // read the original variable instead of a local that only holds a copy of it.
+    bool propagate_copies = false;
     explicit operator bool() const {
-      return fold_constants || prune_unused_functions || prune_unused_locals || prune_unused_globals;
+      return fold_constants || prune_unused_functions || prune_unused_locals || prune_unused_globals
+          || propagate_constants || prune_dead_code || inline_functions || eliminate_common_subexprs
+          || hoist_loop_invariants || prune_dead_stores || propagate_copies;
     }
 };
 
+// Removes the statement from its parent, leaving an empty statement behind
+// wherever there has to be one.
+void remove_statement(LSLStatement *stmt);
+
 class TreeSimplifyingVisitor: public DepthFirstASTVisitor {
   public:
     explicit TreeSimplifyingVisitor(const OptimizationOptions &opts): mOpts(opts) {};
@@ -28,8 +52,17 @@ class TreeSimplifyingVisitor: public DepthFirstASTVisitor {
     virtual bool visit(LSLExpression *expr);
     virtual bool visit(LSLLValueExpression *lvalue);
     virtual bool visit(LSLConstantExpression *constant_expr);
+    virtual bool visit(LSLCompoundStatement *compound_stmt);
+    virtual bool visit(LSLIfStatement *if_stmt);
+    virtual bool visit(LSLWhileStatement *while_stmt);
+    virtual bool visit(LSLDoStatement *do_stmt);
+    virtual bool visit(LSLForStatement *for_stmt);
 
     bool handleGlobal(LSLASTNode *glob);
+    // Re-check the declarations of symbols that lost references since they were
+    // last looked at, pruning any that became unused. Anything this prunes gets
+    // queued onto `released` in turn.
+    void pruneReleasedSymbols(LSLScript *script, std::vector<LSLSymbol *> &released);
 };
 }
 
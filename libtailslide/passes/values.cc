@@ -1,3 +1,6 @@
+#include <cstring>
+#include <vector>
+
 #include "../lslmini.hh"
 
 #include "values.hh"
@@ -150,57 +153,64 @@ bool ConstantDeterminingVisitor::visit(LSLLValueExpression *lvalue) {
   if (symbol->getAssignments() == 0 || lvalue->getInGlobalContext()) {
     constant_value = symbol->getConstantValue();
 
-    if (constant_value != nullptr && member_name != nullptr) { // getting a member_name
-      switch (constant_value->getIType()) {
-        case LST_VECTOR: {
-          auto *c = (LSLVectorConstant *) constant_value;
-          auto *v = (Vector3 *) c->getValue();
-          assert(v);
-          switch (member_name[0]) {
-            case 'x':
-              constant_value = _mAllocator->newTracked<LSLFloatConstant>(v->x);
-              break;
-            case 'y':
-              constant_value = _mAllocator->newTracked<LSLFloatConstant>(v->y);
-              break;
-            case 'z':
-              constant_value = _mAllocator->newTracked<LSLFloatConstant>(v->z);
-              break;
-            default:
-              constant_value = nullptr;
-          }
+    if (constant_value != nullptr)
+      constant_value = getMemberValue(constant_value, member_name);
+  }
+  lvalue->setConstantValue(constant_value);
+  return true;
+}
+
+LSLConstant *ConstantDeterminingVisitor::getMemberValue(LSLConstant *cv, const char *member_name) {
+  if (member_name == nullptr)
+    return cv;
+  LSLConstant *constant_value = cv;
+  switch (constant_value->getIType()) {
+    case LST_VECTOR: {
+      auto *c = (LSLVectorConstant *) constant_value;
+      auto *v = (Vector3 *) c->getValue();
+      assert(v);
+      switch (member_name[0]) {
+        case 'x':
+          constant_value = _mConstants->getFloat(v->x);
+          break;
+        case 'y':
+          constant_value = _mConstants->getFloat(v->y);
           break;
-        }
-        case LST_QUATERNION: {
-          auto *c = (LSLQuaternionConstant *) constant_value;
-          auto *v = (Quaternion *) c->getValue();
-          assert(v);
-          switch (member_name[0]) {
-            case 'x':
-              constant_value = _mAllocator->newTracked<LSLFloatConstant>(v->x);
-              break;
-            case 'y':
-              constant_value = _mAllocator->newTracked<LSLFloatConstant>(v->y);
-              break;
-            case 'z':
-              constant_value = _mAllocator->newTracked<LSLFloatConstant>(v->z);
-              break;
-            case 's':
-              constant_value = _mAllocator->newTracked<LSLFloatConstant>(v->s);
-              break;
-            default:
-              constant_value = nullptr;
-          }
+        case 'z':
+          constant_value = _mConstants->getFloat(v->z);
           break;
-        }
         default:
           constant_value = nullptr;
+      }
+      break;
+    }
+    case LST_QUATERNION: {
+      auto *c = (LSLQuaternionConstant *) constant_value;
+      auto *v = (Quaternion *) c->getValue();
+      assert(v);
+      switch (member_name[0]) {
+        case 'x':
+          constant_value = _mConstants->getFloat(v->x);
           break;
+        case 'y':
+          constant_value = _mConstants->getFloat(v->y);
+          break;
+        case 'z':
+          constant_value = _mConstants->getFloat(v->z);
+          break;
+        case 's':
+          constant_value = _mConstants->getFloat(v->s);
+          break;
+        default:
+          constant_value = nullptr;
       }
+      break;
     }
+    default:
+      constant_value = nullptr;
+      break;
   }
-  lvalue->setConstantValue(constant_value);
-  return true;
+  return constant_value;
 }
 
 bool ConstantDeterminingVisitor::visit(LSLListExpression *list_expr) {
@@ -258,7 +268,7 @@ bool ConstantDeterminingVisitor::visit(LSLVectorExpression *vec_expr) {
     return true;
 
   // create constant value
-  vec_expr->setConstantValue(_mAllocator->newTracked<LSLVectorConstant>(v[0], v[1], v[2]));
+  vec_expr->setConstantValue(_mConstants->getVector(v[0], v[1], v[2]));
   return true;
 }
 
@@ -297,7 +307,7 @@ bool ConstantDeterminingVisitor::visit(LSLQuaternionExpression *quat_expr) {
     return true;
 
   // create constant value
-  quat_expr->setConstantValue(_mAllocator->newTracked<LSLQuaternionConstant>(v[0], v[1], v[2], v[3]));
+  quat_expr->setConstantValue(_mConstants->getQuaternion(v[0], v[1], v[2], v[3]));
   return true;
 }
 
@@ -315,5 +325,68 @@ bool ConstantDeterminingVisitor::visit(LSLTypecastExpression *cast_expr) {
   return true;
 }
 
+bool ConstantDeterminingVisitor::visit(LSLFunctionExpression *func_expr) {
+  func_expr->setConstantValue(nullptr);
+  auto *sym = func_expr->getSymbol();
+  // only calls to pure builtins are the same every time
+  if (!sym || sym->getSubType() != SYM_BUILTIN || !sym->hasBuiltinAttr(BUILTIN_ATTR_PURE))
+    return true;
+  auto *params = sym->getFunctionDecl();
+  auto *args = func_expr->getArguments();
+  if (!params || params->getNumChildren() != args->getNumChildren())
+    return true;
+
+  std::vector<LSLConstant *> arg_cvs;
+  auto *param = params->getChild(0);
+  for (auto *arg : *args) {
+    auto *cv = arg->getConstantValue();
+    if (!cv) {
+      func_expr->setConstantPrecluded(arg->getConstantPrecluded());
+      return true;
+    }
+    // integer arguments to float parameters and the like
+    auto *param_type = param->getType();
+    if (cv->getType() != param_type) {
+      if (!cv->getType()->canCoerce(param_type))
+        return true;
+      cv = _mOperationBehavior->cast(param_type, cv, cv->getLoc());
+      if (!cv)
+        return true;
+    }
+    arg_cvs.push_back(cv);
+    param = param->getNext();
+  }
+  func_expr->setConstantValue(_mOperationBehavior->call(sym, arg_cvs.data(), func_expr->getLoc()));
+  return true;
+}
+
+// `0.0` and `-0.0` compare equal but don't behave the same, so they don't count as identical.
+bool constants_identical(LSLConstant *a, LSLConstant *b) {
+  if (a == b)
+    return true;
+  if (!a || !b || a->getIType() != b->getIType())
+    return false;
+  switch (a->getIType()) {
+    case LST_INTEGER:
+      return ((LSLIntegerConstant *) a)->getValue() == ((LSLIntegerConstant *) b)->getValue();
+    case LST_FLOATINGPOINT: {
+      double a_val = ((LSLFloatConstant *) a)->getValue();
+      double b_val = ((LSLFloatConstant *) b)->getValue();
+      return !memcmp(&a_val, &b_val, sizeof(double));
+    }
+    case LST_STRING:
+    case LST_KEY:
+      return !strcmp(((LSLStringConstant *) a)->getValue(), ((LSLStringConstant *) b)->getValue());
+    case LST_VECTOR:
+      return !memcmp(((LSLVectorConstant *) a)->getValue(), ((LSLVectorConstant *) b)->getValue(), sizeof(Vector3));
+    case LST_QUATERNION:
+      return !memcmp(
+          ((LSLQuaternionConstant *) a)->getValue(), ((LSLQuaternionConstant *) b)->getValue(), sizeof(Quaternion));
+    default:
+      // not worth comparing lists element by element, a list that isn't touched
+      // keeps the same constant anyway.
+      return false;
+  }
+}
 
 }
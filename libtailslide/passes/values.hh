@@ -8,8 +8,11 @@
 namespace Tailslide {
 class ConstantDeterminingVisitor : public DepthFirstASTVisitor {
   public:
-    explicit ConstantDeterminingVisitor(AOperationBehavior *behavior, ScriptAllocator *allocator)
-        : _mOperationBehavior(behavior), _mAllocator(allocator) {}
+    explicit ConstantDeterminingVisitor(
+        AOperationBehavior *behavior, ScriptAllocator *allocator, ConstantPool *constants=nullptr)
+        : _mOperationBehavior(behavior), _mAllocator(allocator), _mOwnConstants(allocator) {
+      _mConstants = constants ? constants : &_mOwnConstants;
+    }
 
     virtual bool beforeDescend(LSLASTNode *node);
 
@@ -22,12 +25,21 @@ class ConstantDeterminingVisitor : public DepthFirstASTVisitor {
     virtual bool visit(LSLVectorExpression *vec_expr);
     virtual bool visit(LSLQuaternionExpression *quat_expr);
     virtual bool visit(LSLTypecastExpression *cast_expr);
+    virtual bool visit(LSLFunctionExpression *func_expr);
   protected:
     AOperationBehavior *_mOperationBehavior = nullptr;
     ScriptAllocator *_mAllocator;
+    ConstantPool *_mConstants;
+    ConstantPool _mOwnConstants;
 
     void handleDeclaration(LSLASTNode *decl_node);
+    // value of `.x` / `.y` / `.z` / `.s` on a constant, `cv` itself if there's no member
+    LSLConstant *getMemberValue(LSLConstant *cv, const char *member_name);
 };
+
+/// Whether two constants are the same value, down to the bit pattern of any floats.
+/// Lists are only identical to themselves.
+bool constants_identical(LSLConstant *a, LSLConstant *b);
 }
 
 #endif //TAILSLIDE_VALUES_HH
@@ -0,0 +1,81 @@
+#include <cinttypes>
+#include <cstring>
+
+#include "diagnostics.hh"
+#include "profiler.hh"
+#include "visitor.hh"
+
+namespace Tailslide {
+
+PassProfile &PassProfiler::getProfile(const char *name) {
+  // only ever a handful of passes, not worth hashing
+  for (auto &profile : _mProfiles) {
+    if (!strcmp(profile.name, name))
+      return profile;
+  }
+  _mProfiles.push_back({name});
+  return _mProfiles.back();
+}
+
+void PassProfiler::printTable(FILE *fp) const {
+  fprintf(fp, "%-24s %6s %12s %12s %12s %10s\n", "PASS", "RUNS", "TIME (ms)", "VISITS", "ALLOC BYTES", "ALLOCS");
+  for (auto &profile : _mProfiles) {
+#ifdef TAILSLIDE_PROFILE_COUNTERS
+    fprintf(fp, "%-24s %6" PRIu32 " %12.3f %12" PRIu64 " %12" PRIu64 " %10" PRIu64 "\n",
+            profile.name, profile.runs, (double)profile.wall_ns / 1000000.0,
+            profile.node_visits, profile.alloc_bytes, profile.alloc_objects);
+#else
+    fprintf(fp, "%-24s %6" PRIu32 " %12.3f %12s %12s %10" PRIu64 "\n",
+            profile.name, profile.runs, (double)profile.wall_ns / 1000000.0,
+            "-", "-", profile.alloc_objects);
+#endif
+  }
+}
+
+void PassProfiler::writeJSON(std::string &out) const {
+  out += "{\"passes\":[";
+  bool first = true;
+  for (auto &profile : _mProfiles) {
+    if (!first)
+      out += ',';
+    first = false;
+    out += "{\"name\":";
+    append_json_string(out, profile.name);
+    out += ",\"runs\":" + std::to_string(profile.runs);
+    out += ",\"wall_ns\":" + std::to_string(profile.wall_ns);
+#ifdef TAILSLIDE_PROFILE_COUNTERS
+    out += ",\"node_visits\":" + std::to_string(profile.node_visits);
+    out += ",\"alloc_bytes\":" + std::to_string(profile.alloc_bytes);
+#endif
+    out += ",\"alloc_objects\":" + std::to_string(profile.alloc_objects);
+    out += '}';
+  }
+  out += "]}";
+}
+
+void PassProfileScope::start(ScriptContext *ctx, ASTVisitor *visitor) {
+  _mAllocator = ctx->allocator;
+  _mVisitor = visitor;
+  if (_mVisitor)
+    _mStartVisits = _mVisitor->mNodeVisits;
+  if (_mAllocator) {
+    _mStartBytes = _mAllocator->getAllocatedBytes();
+    _mStartObjects = _mAllocator->getAllocatedObjects();
+  }
+  _mStartTime = std::chrono::steady_clock::now();
+}
+
+void PassProfileScope::stop() {
+  auto elapsed = std::chrono::steady_clock::now() - _mStartTime;
+  auto &profile = _mProfiler->getProfile(_mName);
+  ++profile.runs;
+  profile.wall_ns += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  if (_mVisitor)
+    profile.node_visits += _mVisitor->mNodeVisits - _mStartVisits;
+  if (_mAllocator) {
+    profile.alloc_bytes += _mAllocator->getAllocatedBytes() - _mStartBytes;
+    profile.alloc_objects += _mAllocator->getAllocatedObjects() - _mStartObjects;
+  }
+}
+
+}
@@ -0,0 +1,83 @@
+#ifndef TAILSLIDE_PROFILER_HH
+#define TAILSLIDE_PROFILER_HH
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "lslmini.hh"
+#include "tracing.hh"
+
+namespace Tailslide {
+
+class ASTVisitor;
+
+struct PassProfile {
+  const char *name;
+  uint32_t runs = 0;
+  uint64_t wall_ns = 0;
+  uint64_t node_visits = 0;
+  uint64_t alloc_bytes = 0;
+  uint64_t alloc_objects = 0;
+};
+
+/// Per-pass timing and allocation stats for a script. Hang one off `ScriptContext::profiler`
+/// to turn profiling on, passes that run more than once are summed under the same name.
+/// Numbers for nested passes are included in the pass that contains them.
+/// Node visits and allocated bytes have to be counted as they happen, so they're only
+/// available in builds with TAILSLIDE_PROFILE_COUNTERS and are left out of the output otherwise.
+class PassProfiler {
+  public:
+    void clear() { _mProfiles.clear(); }
+    const std::vector<PassProfile> &getProfiles() const { return _mProfiles; }
+    PassProfile &getProfile(const char *name);
+
+    void printTable(FILE *fp) const;
+    void writeJSON(std::string &out) const;
+
+  private:
+    std::vector<PassProfile> _mProfiles {};
+};
+
+/// Profiles a pass for as long as it's in scope, does nothing if there's no profiler.
+/// `visitor` is the visitor doing the pass's work, if we should count its node visits.
+/// Also marks the pass's begin and end in the trace for tracing builds.
+class PassProfileScope {
+  public:
+    PassProfileScope(ScriptContext *ctx, const char *name, ASTVisitor *visitor=nullptr)
+        : _mProfiler(ctx->profiler), _mName(name) {
+#ifdef TAILSLIDE_TRACING
+      tailslide_trace_begin(name);
+#endif
+      if (_mProfiler)
+        start(ctx, visitor);
+    }
+    ~PassProfileScope() {
+      if (_mProfiler)
+        stop();
+#ifdef TAILSLIDE_TRACING
+      tailslide_trace_end(_mName);
+#endif
+    }
+    PassProfileScope(const PassProfileScope &) = delete;
+    PassProfileScope &operator=(const PassProfileScope &) = delete;
+
+  private:
+    void start(ScriptContext *ctx, ASTVisitor *visitor);
+    void stop();
+
+    PassProfiler *_mProfiler;
+    const char *_mName;
+    ScriptAllocator *_mAllocator = nullptr;
+    ASTVisitor *_mVisitor = nullptr;
+    std::chrono::steady_clock::time_point _mStartTime {};
+    uint64_t _mStartVisits = 0;
+    size_t _mStartBytes = 0;
+    size_t _mStartObjects = 0;
+};
+
+}
+
+#endif
@@ -1,15 +1,23 @@
 #include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <vector>       // vector::iterator
-#include <set>
-#include <string>
+#include <unordered_set>
 
 #include "lslmini.hh"
+#include "name_suggestions.hh"
 #include "symtab.hh"
 
 namespace Tailslide {
 
+LSLSymbolTable::~LSLSymbolTable() {
+  delete _mSuggestionIndex;
+}
+
 void LSLSymbolTable::define(LSLSymbol *symbol) {
   _mSymbols.insert(UnorderedCStrMap<LSLSymbol*>::value_type(symbol->getName(), symbol));
+  if (_mSuggestionIndex)
+    _mSuggestionIndex->insert(symbol);
   DEBUG(
     LOG_DEBUG_SPAM,
     NULL,
@@ -46,53 +54,132 @@ bool LSLSymbolTable::remove(LSLSymbol *symbol) {
   for (auto iter = _mSymbols.begin(); iter != _mSymbols.end(); ++iter) {
     if (iter->second == symbol) {
       _mSymbols.erase(iter);
+      // BK-trees don't support removal, rebuild it next time it's needed.
+      delete _mSuggestionIndex;
+      _mSuggestionIndex = nullptr;
       return true;
     }
   }
   return false;
 }
 
+void LSLSymbolTable::buildSuggestionIndex() {
+  if (!_mSuggestionIndex)
+    _mSuggestionIndex = new NameSuggestionIndex();
+  _mSuggestionIndex->clear();
+  for (auto &symbol: _mSymbols) {
+    _mSuggestionIndex->insert(symbol.second);
+  }
+}
+
+bool LSLSymbolTable::suggest(const char *name, LSLSymbolType type, int max_dist, NameSuggestion &best) {
+  if (!_mSuggestionIndex)
+    buildSuggestionIndex();
+  return _mSuggestionIndex->findClosest(name, type, max_dist, best);
+}
+
 void LSLSymbolTable::resetTracking() {
   for (auto &symbol: _mSymbols) {
     symbol.second->resetTracking();
   }
 }
 
+// Identifier alphabets for the mangled name encoder. LSL identifiers can't start with a digit.
+static const char MANGLE_LEAD_CHARS[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_";
+static const char MANGLE_TAIL_CHARS[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789";
+static constexpr size_t MANGLE_NUM_LEAD = sizeof(MANGLE_LEAD_CHARS) - 1;
+static constexpr size_t MANGLE_NUM_TAIL = sizeof(MANGLE_TAIL_CHARS) - 1;
+// 53 * 63^6 names is plenty, leaves room for the null terminator.
+static constexpr size_t MANGLE_MAX_LEN = 8;
+
+static const char *LSL_KEYWORDS[] = {
+    "integer", "float", "string", "key", "vector", "quaternion", "rotation", "list",
+    "default", "state", "event", "jump", "return", "if", "else", "for", "do", "while", "print",
+    nullptr
+};
+
+/// Bijective base-N encoding of `idx`, so every index maps to a distinct
+/// identifier and the shortest identifiers come first.
+static void encode_mangled_name(size_t idx, char *out) {
+  size_t len = 0;
+  out[len++] = MANGLE_LEAD_CHARS[idx % MANGLE_NUM_LEAD];
+  idx /= MANGLE_NUM_LEAD;
+  while (idx) {
+    --idx;
+    assert(len < MANGLE_MAX_LEN - 1);
+    out[len++] = MANGLE_TAIL_CHARS[idx % MANGLE_NUM_TAIL];
+    idx /= MANGLE_NUM_TAIL;
+  }
+  out[len] = '\0';
+}
+
+static bool is_lsl_keyword(const char *name) {
+  for (int i = 0; LSL_KEYWORDS[i]; ++i) {
+    if (!strcmp(LSL_KEYWORDS[i], name))
+      return true;
+  }
+  return false;
+}
+
+static bool is_mangleable(LSLSymbol *sym) {
+  // can't rename events or builtin names, obviously!
+  if (sym->getSymbolType() == SYM_EVENT || sym->getSubType() == SYM_BUILTIN)
+    return false;
+  // default state _must_ be named default, can't mangle the name.
+  if (sym->getSymbolType() == SYM_STATE && !strcmp("default", sym->getName()))
+    return false;
+  return true;
+}
+
 /* Oddly enough, using shorter names in globals saves bytecode space. */
 void LSLSymbolTableManager::setMangledNames() {
-  int seq = 0;
-  for (auto &desc_table: _mTables) {
-    auto &node_symbols = desc_table->getMap();
-    // We want mangled symbol name to be consistent across STL implementations,
-    // and our symbol map is specifically unsorted. Place the symbol names in an std::set
-    // which will de-dupe and has a specification-imposed iteration order.
-    std::set<std::string> key_names;
-    for (auto &it: node_symbols) {
-      key_names.insert(it.first);
-    }
-    for (auto &key_name: key_names) {
-      auto range = node_symbols.equal_range(key_name.c_str());
-      for (auto &symbol = range.first; symbol != range.second; ++symbol) {
-        LSLSymbol *sym = symbol->second;
-        // can't rename events or builtin names, obviously!
-        if (sym->getSymbolType() == SYM_EVENT || sym->getSubType() == SYM_BUILTIN)
-          continue;
-        // default state _must_ be named default, can't mangle the name.
-        if (sym->getSymbolType() == SYM_STATE && !strcmp("default", sym->getName()))
-          continue;
-
-        char *mangled_id = _mAllocator->alloc(30);
-        while (true) {
-          snprintf(mangled_id, 30, "_%x", seq++);
-          // Make sure this name isn't already in use
-          if (!desc_table->lookup(mangled_id, SYM_ANY)) {
-            sym->setMangledName(mangled_id);
-            break;
-          }
-        }
-      }
+  struct MangleCandidate {
+    LSLSymbol *sym;
+    size_t table_idx;
+  };
+  std::vector<MangleCandidate> candidates;
+  // Every name that's already spoken for, whether or not it ends up mangled.
+  // Mangled names never collide with an original name, so mangling one class
+  // of symbols and not another can't introduce shadowing.
+  std::unordered_set<const char *, CStrHash<>, CStrEqualTo<>> taken_names;
+  LSLSymbolTable *builtins = nullptr;
+
+  for (size_t i = 0; i < _mTables.size(); ++i) {
+    auto *table = _mTables[i];
+    if (!builtins && table->mContext)
+      builtins = table->mContext->builtins;
+    for (auto &it : table->getMap()) {
+      taken_names.insert(it.first);
+      if (is_mangleable(it.second))
+        candidates.push_back({it.second, i});
     }
   }
+
+  // Our symbol maps are specifically unsorted, so impose a total order that's
+  // consistent across STL implementations. The most referenced symbols come first
+  // so they get the shortest names.
+  std::sort(candidates.begin(), candidates.end(), [](const MangleCandidate &a, const MangleCandidate &b) {
+    if (a.sym->getReferences() != b.sym->getReferences())
+      return a.sym->getReferences() > b.sym->getReferences();
+    if (a.table_idx != b.table_idx)
+      return a.table_idx < b.table_idx;
+    int name_cmp = strcmp(a.sym->getName(), b.sym->getName());
+    if (name_cmp)
+      return name_cmp < 0;
+    return *a.sym->getLoc() < *b.sym->getLoc();
+  });
+
+  // All the names live in one block rather than one allocation apiece.
+  char *name_buf = _mAllocator->alloc(candidates.size() * MANGLE_MAX_LEN);
+  size_t seq = 0;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    char *mangled_id = name_buf + (i * MANGLE_MAX_LEN);
+    do {
+      encode_mangled_name(seq++, mangled_id);
+    } while (taken_names.count(mangled_id) || is_lsl_keyword(mangled_id)
+             || (builtins && builtins->lookup(mangled_id, SYM_ANY)));
+    candidates[i].sym->setMangledName(mangled_id);
+  }
 }
 
 void LSLSymbolTableManager::resetTracking() {
@@ -101,6 +188,78 @@ void LSLSymbolTableManager::resetTracking() {
   }
 }
 
+void LSLSymbol::resetTracking() {
+  _mAssignments = 0;
+  _mReferences = 0;
+  while (_mFirstUse)
+    removeUse(_mFirstUse);
+  while (_mFirstDef)
+    removeDef(_mFirstDef);
+}
+
+void LSLSymbol::addUse(LSLIdentifier *id) {
+  if (_mSubType == SYM_BUILTIN) {
+    addReference();
+    return;
+  }
+  if (id->_mUseOf == this)
+    return;
+  assert(!id->_mUseOf);
+  id->_mUseOf = this;
+  id->_mPrevUse = nullptr;
+  id->_mNextUse = _mFirstUse;
+  if (_mFirstUse)
+    _mFirstUse->_mPrevUse = id;
+  _mFirstUse = id;
+  ++_mReferences;
+}
+
+void LSLSymbol::removeUse(LSLIdentifier *id) {
+  if (_mSubType == SYM_BUILTIN) {
+    removeReference();
+    return;
+  }
+  // uses that were never counted, like recursive calls, aren't on the list.
+  if (id->_mUseOf != this)
+    return;
+  if (id->_mPrevUse)
+    id->_mPrevUse->_mNextUse = id->_mNextUse;
+  else
+    _mFirstUse = id->_mNextUse;
+  if (id->_mNextUse)
+    id->_mNextUse->_mPrevUse = id->_mPrevUse;
+  id->_mUseOf = nullptr;
+  id->_mPrevUse = id->_mNextUse = nullptr;
+  removeReference();
+}
+
+void LSLSymbol::addDef(LSLExpression *expr) {
+  if (expr->_mDefOf == this)
+    return;
+  assert(!expr->_mDefOf);
+  expr->_mDefOf = this;
+  expr->_mPrevDef = nullptr;
+  expr->_mNextDef = _mFirstDef;
+  if (_mFirstDef)
+    _mFirstDef->_mPrevDef = expr;
+  _mFirstDef = expr;
+  ++_mAssignments;
+}
+
+void LSLSymbol::removeDef(LSLExpression *expr) {
+  if (expr->_mDefOf != this)
+    return;
+  if (expr->_mPrevDef)
+    expr->_mPrevDef->_mNextDef = expr->_mNextDef;
+  else
+    _mFirstDef = expr->_mNextDef;
+  if (expr->_mNextDef)
+    expr->_mNextDef->_mPrevDef = expr->_mPrevDef;
+  expr->_mDefOf = nullptr;
+  expr->_mPrevDef = expr->_mNextDef = nullptr;
+  removeAssignment();
+}
+
 LSLIType LSLSymbol::getIType() {
   return _mType->getIType();
 }
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "allocator.hh"
+#include "loctype.hh"
 #include "unordered_cstr_map.hh"
 
 namespace Tailslide {
@@ -29,6 +30,21 @@ enum LSLSymbolType       { SYM_ANY = -1, SYM_VARIABLE, SYM_FUNCTION, SYM_STATE,
 enum LSLSymbolTableType  { SYMTAB_GLOBAL, SYMTAB_STATE, SYMTAB_FUNCTION, SYMTAB_LEXICAL, SYMTAB_BUILTINS };
 enum LSLSymbolSubType    { SYM_LOCAL, SYM_GLOBAL, SYM_BUILTIN, SYM_FUNCTION_PARAMETER, SYM_EVENT_PARAMETER };
 
+// What calling a builtin function might do, from the attributes listed in builtins.txt
+enum LSLBuiltinAttr : uint8_t {
+  BUILTIN_ATTR_NONE          = 0,
+  // only computes something from its arguments, implies `BUILTIN_ATTR_DETERMINISTIC`
+  BUILTIN_ATTR_PURE          = 1 << 0,
+  // the result depends on state outside the script
+  BUILTIN_ATTR_READS_WORLD   = 1 << 1,
+  // changes something other than the script's variables
+  BUILTIN_ATTR_WRITES_WORLD  = 1 << 2,
+  // has a forced delay
+  BUILTIN_ATTR_MAY_SLEEP     = 1 << 3,
+  // gives the same result for the same arguments as long as the world doesn't change
+  BUILTIN_ATTR_DETERMINISTIC = 1 << 4,
+};
+
 class LSLSymbol: public TrackableObject {
   public:
     LSLSymbol( ScriptContext *ctx, const char *name, class LSLType *type, LSLSymbolType symbol_type, LSLSymbolSubType sub_type, YYLTYPE *lloc, class LSLParamList *function_decl = NULL, class LSLASTNode *var_decl = NULL, class LSLLabel *label_decl = NULL  )
@@ -49,7 +65,18 @@ class LSLSymbol: public TrackableObject {
     int                  getAssignments() const  { return _mAssignments; }
     int                  addAssignment()   { return ++_mAssignments; }
     void                 removeAssignment() { if (_mAssignments > 0) --_mAssignments; }
-    void                 resetTracking()   { _mAssignments = 0; _mReferences = 0; }
+    void                 resetTracking();
+
+    // Identifiers currently in the tree that refer to this symbol, and expressions
+    // that assign to it. Linked in and out as nodes are added to or removed from the
+    // tree, so the lists always agree with `getReferences()` and `getAssignments()`.
+    // Builtin symbols are shared between scripts and only keep the counts.
+    class LSLIdentifier *getFirstUse() { return _mFirstUse; }
+    class LSLExpression *getFirstDef() { return _mFirstDef; }
+    void addUse(class LSLIdentifier *id);
+    void removeUse(class LSLIdentifier *id);
+    void addDef(class LSLExpression *expr);
+    void removeDef(class LSLExpression *expr);
 
     LSLSymbolType         getSymbolType()  { return _mSymbolType; }
     LSLSymbolSubType      getSubType()     { return _mSubType;    }
@@ -84,6 +111,10 @@ class LSLSymbol: public TrackableObject {
 
     bool getHasJumps() const { return _mHasJumps; }
     void setHasJumps(bool has_jumps) { _mHasJumps = has_jumps; }
+
+    uint8_t getBuiltinAttrs() const { return _mBuiltinAttrs; }
+    void setBuiltinAttrs(uint8_t attrs) { _mBuiltinAttrs = attrs; }
+    bool hasBuiltinAttr(LSLBuiltinAttr attr) const { return (_mBuiltinAttrs & attr) != 0; }
     bool getHasUnstructuredJumps() const { return _mHasUnstructuredJumps; }
     void setHasUnstructuredJumps(bool unstructured_jumps) { _mHasUnstructuredJumps = unstructured_jumps; }
 
@@ -101,25 +132,37 @@ class LSLSymbol: public TrackableObject {
     bool _mConstantPrecluded = false;
     int                  _mReferences;            // how many times this symbol is referred to
     int                  _mAssignments;           // how many times it is assigned to
+    class LSLIdentifier *_mFirstUse = nullptr;
+    class LSLExpression *_mFirstDef = nullptr;
     char                *_mMangledName;
     bool _mAllPathsReturn = false;
     bool _mHasJumps = false;
     // if the function contains jumps that are not break-like or continue-like
     bool _mHasUnstructuredJumps = false;
+    uint8_t _mBuiltinAttrs = BUILTIN_ATTR_NONE;
 };
 
 class LSLSymbolTable: public TrackableObject {
   public:
     explicit LSLSymbolTable(ScriptContext *ctx, LSLSymbolTableType symtab_type)
       : TrackableObject(ctx), _mSymbolTableType(symtab_type) {};
+    ~LSLSymbolTable() override;
     LSLSymbol *lookup( const char *name, LSLSymbolType type = SYM_ANY );
     void            define( LSLSymbol *symbol );
     bool            remove( LSLSymbol *symbol );
     void            checkSymbols();
     void resetTracking();
 
+    // Find the closest name to `name` for "did you mean" errors, replacing `best`
+    // if this table has a closer match. The index is built on first use and
+    // kept up to date afterwards, tables shared between threads should call
+    // `buildSuggestionIndex()` up-front.
+    bool suggest(const char *name, LSLSymbolType type, int max_dist, struct NameSuggestion &best);
+    void buildSuggestionIndex();
+
   private:
     UnorderedCStrMap<LSLSymbol *> _mSymbols;
+    class NameSuggestionIndex *_mSuggestionIndex = nullptr;
     std::vector<class LSLLabel *> _mLabels;
     LSLSymbolTableType _mSymbolTableType;
 
@@ -1,6 +1,7 @@
 #include <string>
 
 #include "tailslide.hh"
+#include "profiler.hh"
 #include "lslmini.tab.hh"
 
 int tailslide_lex_init_extra(Tailslide::ScriptContext *, void **);
@@ -13,8 +14,9 @@ namespace Tailslide {
 
 extern LSLSymbolTable gBuiltinsSymbolTable;
 
-ScopedScriptParser::ScopedScriptParser(LSLSymbolTable *builtins) : logger(&allocator), table_manager(&allocator) {
+ScopedScriptParser::ScopedScriptParser(LSLSymbolTable *builtins) : logger(&allocator), table_manager(&allocator), constant_pool(&allocator) {
   context.allocator = &allocator;
+  context.constants = &constant_pool;
   context.logger = &logger;
   context.table_manager = &table_manager;
   if (builtins)
@@ -72,7 +74,10 @@ void ScopedScriptParser::initScanner() {
 void ScopedScriptParser::parseInternal() {
   // parse
   context.parsing = true;
-  tailslide_parse(context.scanner);
+  {
+    PassProfileScope profile_scope(&context, "parse");
+    tailslide_parse(context.scanner);
+  }
   context.parsing = false;
 
   // clean up flex
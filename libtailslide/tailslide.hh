@@ -10,6 +10,7 @@
 #endif
 
 #include "lslmini.hh"
+#include "constant_pool.hh"
 
 namespace Tailslide {
 
@@ -21,6 +22,7 @@ struct ScopedScriptParser {
     bool ast_sane = false;
     ScriptContext context;
     LSLSymbolTableManager table_manager;
+    ConstantPool constant_pool;
 
     LSLScript *parseLSLFile(FILE *yyin);
     LSLScript *parseLSLFile(const std::string &filename);
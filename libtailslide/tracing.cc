@@ -0,0 +1,99 @@
+#include "tracing.hh"
+
+#ifdef TAILSLIDE_TRACING
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "diagnostics.hh"
+#endif
+
+namespace Tailslide {
+
+#ifdef TAILSLIDE_TRACING
+
+struct TraceEvent {
+  const char *name;
+  char phase;
+  uint32_t tid;
+  uint64_t ts_ns;
+  int64_t value;
+};
+
+static std::mutex gTraceMutex;
+static std::vector<TraceEvent> gTraceEvents;
+static const auto gTraceStart = std::chrono::steady_clock::now();
+
+static void add_trace_event(const char *name, char phase, int64_t value) {
+  auto elapsed = std::chrono::steady_clock::now() - gTraceStart;
+  auto ts_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  auto tid = (uint32_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+  std::lock_guard<std::mutex> lock(gTraceMutex);
+  gTraceEvents.push_back({name, phase, tid, ts_ns, value});
+}
+
+void tailslide_trace_begin(const char *name) {
+  add_trace_event(name, 'B', 0);
+}
+
+void tailslide_trace_end(const char *name) {
+  add_trace_event(name, 'E', 0);
+}
+
+void tailslide_trace_counter(const char *name, int64_t value) {
+  add_trace_event(name, 'C', value);
+}
+
+bool tailslide_trace_write(const char *filename) {
+  std::string out {"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"};
+  {
+    std::lock_guard<std::mutex> lock(gTraceMutex);
+    bool first = true;
+    char ts_buf[32];
+    for (auto &event : gTraceEvents) {
+      if (!first)
+        out += ",\n";
+      first = false;
+      out += "{\"name\":";
+      append_json_string(out, event.name);
+      out += ",\"ph\":\"";
+      out += event.phase;
+      // timestamps are in microseconds
+      snprintf(ts_buf, sizeof(ts_buf), "%.3f", (double)event.ts_ns / 1000.0);
+      out += "\",\"ts\":";
+      out += ts_buf;
+      out += ",\"pid\":1,\"tid\":" + std::to_string(event.tid);
+      if (event.phase == 'C')
+        out += ",\"args\":{\"value\":" + std::to_string(event.value) + "}";
+      out += '}';
+    }
+  }
+  out += "\n]}\n";
+
+  FILE *fp = fopen(filename, "wb");
+  if (fp == nullptr)
+    return false;
+  bool written = fwrite(out.data(), 1, out.size(), fp) == out.size();
+  return (fclose(fp) == 0) && written;
+}
+
+void tailslide_trace_clear() {
+  std::lock_guard<std::mutex> lock(gTraceMutex);
+  gTraceEvents.clear();
+}
+
+#else
+
+void tailslide_trace_begin(const char *name) {}
+void tailslide_trace_end(const char *name) {}
+void tailslide_trace_counter(const char *name, int64_t value) {}
+bool tailslide_trace_write(const char *filename) { return false; }
+void tailslide_trace_clear() {}
+
+#endif
+
+}
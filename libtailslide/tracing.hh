@@ -0,0 +1,32 @@
+#ifndef TAILSLIDE_TRACING_HH
+#define TAILSLIDE_TRACING_HH
+
+#include <cstdint>
+
+namespace Tailslide {
+
+// Event tracing in Chrome's trace_event format, for builds configured with TAILSLIDE_TRACING.
+// Events from every script processed go into the same trace so a whole batch run can be
+// loaded into chrome://tracing or Perfetto. Names must be string literals, or at least
+// outlive the trace. These do nothing in builds without tracing.
+void tailslide_trace_begin(const char *name);
+void tailslide_trace_end(const char *name);
+void tailslide_trace_counter(const char *name, int64_t value);
+bool tailslide_trace_write(const char *filename);
+void tailslide_trace_clear();
+
+}
+
+#ifndef HIDE_TAILSLIDE_INTERNALS
+#ifdef TAILSLIDE_TRACING
+#define TRACE_BEGIN(name) ::Tailslide::tailslide_trace_begin(name)
+#define TRACE_END(name) ::Tailslide::tailslide_trace_end(name)
+#define TRACE_COUNTER(name, value) ::Tailslide::tailslide_trace_counter((name), (int64_t)(value))
+#else
+#define TRACE_BEGIN(name) do {} while(0)
+#define TRACE_END(name) do {} while(0)
+#define TRACE_COUNTER(name, value) do {} while(0)
+#endif
+#endif
+
+#endif
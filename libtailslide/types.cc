@@ -8,7 +8,7 @@
 namespace Tailslide {
 // TODO: use structs or something here
 
-const static int COERCION_TABLE[][2] = {
+constexpr static int COERCION_TABLE[][2] = {
         // wanted type      acceptable type
         {LST_FLOATINGPOINT, LST_INTEGER},
         {LST_STRING,        LST_KEY},
@@ -29,7 +29,7 @@ const static int LEGAL_CAST_TABLE[LST_MAX][LST_MAX] = {
     /* ERROR  */ {0},
 };
 
-const static int OPERATOR_RESULTS[][4] = {
+constexpr static int OPERATOR_RESULTS[][4] = {
 
         // operator   left type           right type          result type
         // ++
@@ -181,6 +181,77 @@ const static int OPERATOR_RESULTS[][4] = {
         {-1,          -1,                -1,                -1},
 };
 
+// The tables above are the source of truth, but scanning them for every expression
+// is slow. Flatten them into direct lookup tables at compile time instead.
+
+// marks combinations with no valid result in OPERATOR_RESULT_TABLE
+constexpr static uint8_t NO_RESULT = 0xFF;
+// right-hand index used for unary operations
+constexpr static int RHS_NONE = LST_MAX;
+
+struct OperatorResultTable {
+  // [operator][left type][right type or RHS_NONE] -> result type
+  uint8_t results[256][LST_MAX][LST_MAX + 1];
+};
+
+constexpr static OperatorResultTable build_operator_result_table() {
+  OperatorResultTable table {};
+  for (auto &op_results : table.results) {
+    for (auto &left_results : op_results) {
+      for (auto &result : left_results)
+        result = NO_RESULT;
+    }
+  }
+
+  for (int i = 0; OPERATOR_RESULTS[i][0] != -1; ++i) {
+    const auto &operator_params = OPERATOR_RESULTS[i];
+    for (int left = 0; left < LST_MAX; ++left) {
+      // the left side must match our left side
+      if (operator_params[1] != left && (operator_params[1] != LST_ANY || left == LST_NULL))
+        continue;
+      for (int right = 0; right <= RHS_NONE; ++right) {
+        bool match = false;
+        if (right == RHS_NONE)
+          // right IS empty and matches nothing
+          match = (operator_params[2] == LST_NONE);
+        else
+          // or right isn't empty and matches our side
+          match = ((operator_params[2] == LST_ANY && right != LST_NULL) || operator_params[2] == right);
+        if (!match)
+          continue;
+
+        // first matching row wins
+        auto &result = table.results[operator_params[0]][left][right];
+        if (result == NO_RESULT)
+          result = (uint8_t)operator_params[3];
+      }
+    }
+  }
+  return table;
+}
+
+struct CoercionTable {
+  // [from type][to type] -> whether from can be used where to is wanted
+  bool allowed[LST_MAX][LST_MAX];
+};
+
+constexpr static CoercionTable build_coercion_table() {
+  CoercionTable table {};
+  for (int from = 0; from < LST_MAX; ++from) {
+    for (int to = 0; to < LST_MAX; ++to) {
+      // error type matches anything, and if we're already of the target type
+      // then of course we can be used for it
+      table.allowed[from][to] = (from == LST_ERROR || to == LST_ERROR || from == to);
+    }
+  }
+  for (int i = 0; COERCION_TABLE[i][1] != -1; ++i)
+    table.allowed[COERCION_TABLE[i][1]][COERCION_TABLE[i][0]] = true;
+  return table;
+}
+
+constexpr static OperatorResultTable OPERATOR_RESULT_TABLE = build_operator_result_table();
+constexpr static CoercionTable COERCION_LOOKUP_TABLE = build_coercion_table();
+
 LSLType LSLType::_sTypes[LST_MAX] = { // NOLINT(cert-err58-cpp)
         LSLType(LST_NULL, true),
         LSLType(LST_INTEGER, true),
@@ -194,27 +265,10 @@ LSLType LSLType::_sTypes[LST_MAX] = { // NOLINT(cert-err58-cpp)
 };
 
 bool LSLType::canCoerce(LSLType *to) {
-  int i;
-
-  // error type matches anything
-  if (getIType() == LST_ERROR || to->getIType() == LST_ERROR)
-    return true;
-
-  // if we're already of the target type, then of course we can be used for it
-  if (getIType() == to->getIType())
-    return true;
-
-  for (i = 0; COERCION_TABLE[i][1] != -1; i++) {
-    if (COERCION_TABLE[i][1] == getIType() && COERCION_TABLE[i][0] == to->getIType()) {
-      return true;
-    }
-  }
-  return false;
+  return COERCION_LOOKUP_TABLE.allowed[getIType()][to->getIType()];
 }
 
 class LSLType *LSLType::getResultType(LSLOperator op, LSLType *right) {
-  int i;
-
   // error on either side is always error
   if (getIType() == LST_ERROR || (right != nullptr && right->getIType() == LST_ERROR))
     return TYPE(LST_ERROR);
@@ -228,57 +282,33 @@ class LSLType *LSLType::getResultType(LSLOperator op, LSLType *right) {
   op = decouple_compound_operation(op);
   bool compound_assignment = (op != orig_operation);
 
-  // go through each entry in the operator result table
-  for (i = 0; OPERATOR_RESULTS[i][0] != -1; i++) {
-
-    const auto &operator_params = OPERATOR_RESULTS[i];
-    // no operator match
-    if (operator_params[0] != op)
-      continue;
-
-    // the left side must match our left side
-    if (operator_params[1] != getIType() && (operator_params[1] != LST_ANY || getIType() == LST_NULL))
-      continue;
-
-    bool match;
-
-    if (right == nullptr)
-      // right IS empty and matches nothing
-      match = (operator_params[2] == LST_NONE);
-    else
-      // or right isn't empty and matches our side
-      match = ((operator_params[2] == LST_ANY && right->getIType() != LST_NULL) ||
-               operator_params[2] == (int) right->getIType());
-
-    // no type match on the operation
-    if (!match)
-      continue;
-
-    // send back the type
-    auto *ret_type = TYPE((LSLIType) operator_params[3]);
-    // for compound assignment operators the type of the operation's retval
-    // must additionally match the type of the lvalue, or it is not a valid
-    // compound assignment.
-    // For example, `int_val += 1.0` and `vec *= <1,1,1>` are forbidden.
-    // but something like `float_val += 1` is fine.
-    if (compound_assignment && ret_type != this) {
-      // ... is mostly true, but not entirely. There's one case in LL's compiler
-      // (that was probably a mistake) where `int_val *= float_val` is allowed.
-      // `int_val = int_val * float_val` is not legal since `int_val` must be promoted
-      // to a float which can't be assigned to an int lvalue, but the compound form doesn't
-      // even behave as you'd expect.
-      // In LSO it behaves the same as `(int_val = (integer)(int_val * float_val)) * 0.0`.
-      // In Mono it causes a runtime VM error due to invalid IL if you actually try to use
-      // the retval in something like `llOwnerSay((string)(int_val *= float_val))`.
-      // For now let's just warn and pretend it returns a float, because it sort of does in LSO.
-      if (op == OP_MUL && getIType() == LST_INTEGER && right && right->getIType() == LST_FLOATINGPOINT) {
-        return TYPE(LST_FLOATINGPOINT);
-      }
-      return nullptr;
+  uint8_t result = OPERATOR_RESULT_TABLE.results[op][getIType()][right ? (int)right->getIType() : RHS_NONE];
+  if (result == NO_RESULT)
+    return nullptr;
+
+  // send back the type
+  auto *ret_type = TYPE((LSLIType) result);
+  // for compound assignment operators the type of the operation's retval
+  // must additionally match the type of the lvalue, or it is not a valid
+  // compound assignment.
+  // For example, `int_val += 1.0` and `vec *= <1,1,1>` are forbidden.
+  // but something like `float_val += 1` is fine.
+  if (compound_assignment && ret_type != this) {
+    // ... is mostly true, but not entirely. There's one case in LL's compiler
+    // (that was probably a mistake) where `int_val *= float_val` is allowed.
+    // `int_val = int_val * float_val` is not legal since `int_val` must be promoted
+    // to a float which can't be assigned to an int lvalue, but the compound form doesn't
+    // even behave as you'd expect.
+    // In LSO it behaves the same as `(int_val = (integer)(int_val * float_val)) * 0.0`.
+    // In Mono it causes a runtime VM error due to invalid IL if you actually try to use
+    // the retval in something like `llOwnerSay((string)(int_val *= float_val))`.
+    // For now let's just warn and pretend it returns a float, because it sort of does in LSO.
+    if (op == OP_MUL && getIType() == LST_INTEGER && right && right->getIType() == LST_FLOATINGPOINT) {
+      return TYPE(LST_FLOATINGPOINT);
     }
-    return ret_type;
+    return nullptr;
   }
-  return nullptr;
+  return ret_type;
 }
 
 bool operation_mutates(LSLOperator operation) {
@@ -1,6 +1,8 @@
 #ifndef TAILSLIDE_VISITOR_HH
 #define TAILSLIDE_VISITOR_HH
 
+#include <cstdint>
+
 #include "lslmini.hh"
 
 namespace Tailslide {
@@ -148,6 +150,10 @@ class ASTVisitor {
     // only used for depth-first visitors
     virtual bool beforeDescend(LSLASTNode *node) {return true;}
     virtual bool isDepthFirst() {return false;}
+
+    // number of nodes this visitor has been handed, for profiling.
+    // Only counted in builds with TAILSLIDE_PROFILE_COUNTERS.
+    uint64_t mNodeVisits = 0;
 };
 
 class DepthFirstASTVisitor: public ASTVisitor {
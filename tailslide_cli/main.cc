@@ -1,9 +1,12 @@
 #include <iostream>
 #include <cstdio>
+#include <memory>
 
 #include "cxxopt.hh"
 
 #include "tailslide.hh"
+#include "diagnostics.hh"
+#include "profiler.hh"
 #include "passes/pretty_print.hh"
 #include "passes/tree_print.hh"
 #include "passes/tree_simplifier.hh"
@@ -18,6 +21,17 @@ void version() {
   fprintf(stderr, " based on https://github.com/pclewis/lslint\n");
 }
 
+static void print_code_counts(Logger *logger) {
+  for (int code = E_ERROR; code < E_LAST; ++code) {
+    if (int count = logger->getCodeCount(code))
+      fprintf(stderr, "E%d %d\n", code, count);
+  }
+  for (int code = W_WARNING; code < W_LAST; ++code) {
+    if (int count = logger->getCodeCount(code))
+      fprintf(stderr, "E%d %d\n", code, count);
+  }
+  fprintf(stderr, "TOTAL:: Errors: %d  Warnings: %d\n", logger->getErrors(), logger->getWarnings());
+}
 
 int main(int argc, char **argv) {
   FILE *yyin = nullptr;
@@ -46,11 +60,26 @@ int main(int argc, char **argv) {
       ("O2", "Slightly risky optimizations, logic is partially rewritten")
       ("O3", "Risky optimizations that might render script unreadable by humans")
       ("fold-constants", "Simplify the source by performing constant folding")
+      ("propagate-constants", "With fold-constants, also fold locals that get reassigned using their value where they're read")
+      ("prune-dead-code", "Remove branches that are never taken, loops that never run and unreachable statements")
+      ("inline-funcs", "Inline calls to functions whose body is a single expression")
+      ("eliminate-cse", "Compute repeated side-effect free expressions once, keeping the result in a new local")
+      ("hoist-invariants", "Compute side-effect free expressions that don't change within a loop once before the loop")
+      ("prune-dead-stores", "Remove assignments to locals that are never read afterward")
+      ("propagate-copies", "Read the original variable instead of a local that only holds a copy of it")
       ("prune-globals", "Prune unused globals")
       ("prune-locals", "Prune unused locals")
       ("prune-funcs", "Prune unused functions")
       ("lint", "Only lint the file for errors, don't optimize or pretty print.")
       ("show-tree", "Show the AST after optimizations")
+      ("profile", "Print time and allocations per pass to stderr as a table or json",
+       cxxopts::value<std::string>()->implicit_value("table"))
+#ifdef TAILSLIDE_TRACING
+      ("trace", "Write a Chrome trace of parsing and each pass to a file", cxxopts::value<std::string>())
+#endif
+#ifdef DEBUG_LEVEL
+      ("debug-level", "Print internal debug messages up to this verbosity (1-3)", cxxopts::value<int>())
+#endif
   ;
 
   options.add_options("Compilation")
@@ -58,6 +87,22 @@ int main(int argc, char **argv) {
       ("mono-compile", "Compile to Mono CIL and write to file", cxxopts::value<std::string>())
   ;
 
+  options.add_options("Builtins")
+      ("builtins", "Load builtins from a builtins.txt-style file instead of the default set", cxxopts::value<std::string>())
+      ("builtins-image", "Load builtins from a binary image made with --save-builtins-image", cxxopts::value<std::string>())
+      ("save-builtins-image", "Write the selected builtins to a binary image", cxxopts::value<std::string>())
+  ;
+
+  options.add_options("Diagnostics")
+      ("diagnostics-format", "Format for errors and warnings on stderr: text, jsonl or sarif. "
+                             "Non-text formats are streamed as they're emitted.",
+       cxxopts::value<std::string>()->default_value("text"))
+      ("max-errors", "Give up on the script after this many errors", cxxopts::value<int>())
+      ("max-warnings", "Stop reporting warnings after this many", cxxopts::value<int>())
+      ("max-per-code", "Only report this many diagnostics with the same code", cxxopts::value<int>())
+      ("count-codes", "Only count diagnostics, printing how many of each code there were")
+  ;
+
   options.add_options()
       ("script", "Input script's filename", cxxopts::value<std::string>())
   ;
@@ -84,7 +129,9 @@ int main(int argc, char **argv) {
     return 0;
   }
 
+  std::string script_name = "stdin";
   if (vm.count("script")) {
+    script_name = vm["script"].as<std::string>();
     std::string filename = vm["script"].as<std::string>();
     yyin = fopen(filename.c_str(), "r");
     if (yyin == nullptr) {
@@ -93,6 +140,31 @@ int main(int argc, char **argv) {
     }
   }
 
+  std::unique_ptr<DiagnosticSink> diag_sink;
+  auto diag_format = vm["diagnostics-format"].as<std::string>();
+  if (diag_format == "jsonl") {
+    diag_sink = std::make_unique<JSONLinesDiagnosticSink>(fileno(stderr), script_name.c_str());
+  } else if (diag_format == "sarif") {
+    diag_sink = std::make_unique<SARIFDiagnosticSink>(fileno(stderr), script_name.c_str());
+  } else if (diag_format != "text") {
+    fprintf(stderr, "unknown diagnostics format %s\n", diag_format.c_str());
+    return 1;
+  }
+
+#ifdef DEBUG_LEVEL
+  if (vm.count("debug-level"))
+    tailslide_set_debug_level((LogLevel)(LOG_INFO + vm["debug-level"].as<int>()));
+#endif
+
+  std::string profile_format;
+  if (vm.count("profile")) {
+    profile_format = vm["profile"].as<std::string>();
+    if (profile_format != "table" && profile_format != "json") {
+      fprintf(stderr, "unknown profile format %s\n", profile_format.c_str());
+      return 1;
+    }
+  }
+
   if (vm.count("show-tree"))
     show_tree = true;
   if (vm.count("lint")) {
@@ -107,18 +179,39 @@ int main(int argc, char **argv) {
     optim_ctx.prune_unused_globals = vm.count("prune-globals") != 0;
     optim_ctx.prune_unused_functions = vm.count("prune-funcs") != 0;
     optim_ctx.prune_unused_locals = vm.count("prune-locals") != 0;
+    optim_ctx.propagate_constants = vm.count("propagate-constants") != 0;
+    optim_ctx.prune_dead_code = vm.count("prune-dead-code") != 0;
+    optim_ctx.inline_functions = vm.count("inline-funcs") != 0;
+    optim_ctx.eliminate_common_subexprs = vm.count("eliminate-cse") != 0;
+    optim_ctx.hoist_loop_invariants = vm.count("hoist-invariants") != 0;
+    optim_ctx.prune_dead_stores = vm.count("prune-dead-stores") != 0;
+    optim_ctx.propagate_copies = vm.count("propagate-copies") != 0;
 
     if (vm.count("O2")) {
       optim_ctx.prune_unused_globals = true;
       optim_ctx.prune_unused_locals = true;
       optim_ctx.prune_unused_functions = true;
       optim_ctx.fold_constants = true;
+      optim_ctx.propagate_constants = true;
+      optim_ctx.prune_dead_code = true;
+      optim_ctx.inline_functions = true;
+      optim_ctx.eliminate_common_subexprs = true;
+      optim_ctx.hoist_loop_invariants = true;
+      optim_ctx.prune_dead_stores = true;
+      optim_ctx.propagate_copies = true;
     }
     if (vm.count("O3")) {
       optim_ctx.prune_unused_globals = true;
       optim_ctx.prune_unused_locals = true;
       optim_ctx.prune_unused_functions = true;
       optim_ctx.fold_constants = true;
+      optim_ctx.propagate_constants = true;
+      optim_ctx.prune_dead_code = true;
+      optim_ctx.inline_functions = true;
+      optim_ctx.eliminate_common_subexprs = true;
+      optim_ctx.hoist_loop_invariants = true;
+      optim_ctx.prune_dead_stores = true;
+      optim_ctx.propagate_copies = true;
       // the length of global vars / functions and their params has an impact on bytecode size
       pretty_opts.mangle_global_names = true;
       pretty_opts.mangle_func_names = true;
@@ -129,6 +222,13 @@ int main(int argc, char **argv) {
       optim_ctx.prune_unused_locals = true;
       optim_ctx.prune_unused_functions = true;
       optim_ctx.fold_constants = true;
+      optim_ctx.propagate_constants = true;
+      optim_ctx.prune_dead_code = true;
+      optim_ctx.inline_functions = true;
+      optim_ctx.eliminate_common_subexprs = true;
+      optim_ctx.hoist_loop_invariants = true;
+      optim_ctx.prune_dead_stores = true;
+      optim_ctx.propagate_copies = true;
       pretty_opts.mangle_global_names = true;
       pretty_opts.mangle_func_names = true;
       pretty_opts.mangle_local_names = true;
@@ -136,9 +236,52 @@ int main(int argc, char **argv) {
     }
   }
   tailslide_init_builtins(nullptr);
+
+  LSLSymbolTable *builtins = nullptr;
+  if (vm.count("builtins-image")) {
+    auto image_file = vm["builtins-image"].as<std::string>();
+    builtins = tailslide_load_builtins_image("cli", image_file.c_str());
+    if (builtins == nullptr) {
+      fprintf(stderr, "couldn't load builtins image %s\n", image_file.c_str());
+      return 1;
+    }
+  } else if (vm.count("builtins")) {
+    builtins = tailslide_add_builtins_profile("cli", vm["builtins"].as<std::string>().c_str());
+  }
+
+  if (vm.count("save-builtins-image")) {
+    auto image_file = vm["save-builtins-image"].as<std::string>();
+    if (!tailslide_save_builtins_image(builtins ? builtins : tailslide_get_builtins_profile("default"), image_file.c_str())) {
+      fprintf(stderr, "couldn't write builtins image %s\n", image_file.c_str());
+      return 1;
+    }
+    // nothing else to do if we weren't given a script
+    if (!vm.count("script"))
+      return 0;
+  }
+
   // set up the allocator and logger
-  ScopedScriptParser parser(nullptr);
+  ScopedScriptParser parser(builtins);
   Logger *logger = &parser.logger;
+  PassProfiler profiler;
+  if (!profile_format.empty())
+    parser.context.profiler = &profiler;
+  DiagnosticBudget budget {};
+  if (vm.count("max-errors"))
+    budget.max_errors = vm["max-errors"].as<int>();
+  if (vm.count("max-warnings"))
+    budget.max_warnings = vm["max-warnings"].as<int>();
+  if (vm.count("max-per-code"))
+    budget.default_code_cap = vm["max-per-code"].as<int>();
+  logger->setBudget(budget);
+  bool count_codes = vm.count("count-codes") != 0;
+  if (count_codes) {
+    logger->setCountsOnly(true);
+  } else if (diag_sink) {
+    logger->setSink(diag_sink.get());
+    logger->setRetainMessages(false);
+    diag_sink->begin();
+  }
   bool mono_semantics = !vm.count("lso-compile");
 
   auto script = parser.parseLSLFile(yyin);
@@ -159,46 +302,80 @@ int main(int argc, char **argv) {
       // do these last since symbol usage and expressions may change
       // when rewriting the tree
       script->validateGlobals(mono_semantics);
-      script->checkSymbols();
+      {
+        PassProfileScope profile_scope(&parser.context, "check_symbols");
+        script->checkSymbols();
+      }
       if (pretty_print) {
         parser.table_manager.setMangledNames();
 
         PrettyPrintVisitor print_visitor(pretty_opts);
+        PassProfileScope profile_scope(&parser.context, "pretty_print", &print_visitor);
         script->visit(&print_visitor);
         std::cout << print_visitor.mStream.str() << "\n";
       }
     } else {
       script->validateGlobals(mono_semantics);
+      PassProfileScope profile_scope(&parser.context, "check_symbols");
       script->checkSymbols();
     }
-    logger->printReport();
+    if (count_codes)
+      print_code_counts(logger);
+    else if (!diag_sink)
+      logger->printReport();
     if (show_tree) {
       std::cout << "Tree:" << std::endl;
       TreePrintingVisitor visitor;
       script->visit(&visitor);
       std::cout << visitor.mStream.str();
     }
-  } else {
+  } else if (count_codes) {
+    print_code_counts(logger);
+  } else if (!diag_sink) {
     logger->printReport();
   }
+  if (diag_sink && !count_codes)
+    diag_sink->end();
 
   if (!logger->getErrors()) {
     if (vm.count("lso-compile")) {
       auto lso_dest = vm["lso-compile"].as<std::string>();
       LSOScriptCompiler lso_visitor(&parser.allocator);
-      script->visit(&lso_visitor);
+      {
+        PassProfileScope profile_scope(&parser.context, "lso_compile", &lso_visitor);
+        script->visit(&lso_visitor);
+      }
 
       std::ofstream f(lso_dest, std::ios::binary);
       f.write((const char *) lso_visitor.mScriptBS.data(), (std::streamsize) lso_visitor.mScriptBS.size());
     } else if (vm.count("mono-compile")) {
       auto lso_dest = vm["mono-compile"].as<std::string>();
       MonoScriptCompiler mono_visitor(&parser.allocator);
-      script->visit(&mono_visitor);
+      {
+        PassProfileScope profile_scope(&parser.context, "mono_compile", &mono_visitor);
+        script->visit(&mono_visitor);
+      }
 
       std::ofstream f(lso_dest, std::ios::binary);
       std::string cil_code {mono_visitor.mCIL.str()};
       f.write(cil_code.c_str(), (std::streamsize) cil_code.size());
     }
   }
+
+#ifdef TAILSLIDE_TRACING
+  if (vm.count("trace")) {
+    auto trace_file = vm["trace"].as<std::string>();
+    if (!tailslide_trace_write(trace_file.c_str()))
+      fprintf(stderr, "couldn't write trace %s\n", trace_file.c_str());
+  }
+#endif
+
+  if (profile_format == "json") {
+    std::string profile_json;
+    profiler.writeJSON(profile_json);
+    fprintf(stderr, "%s\n", profile_json.c_str());
+  } else if (!profile_format.empty()) {
+    profiler.printTable(stderr);
+  }
   return logger->getErrors();
 }
@@ -157,6 +157,137 @@ TEST_CASE("parser_abuse.lsl") {
   checkPrettyPrintOutput("parser_abuse.lsl", ctx, pretty_ctx);
 }
 
+TEST_CASE("mutual_recursion.lsl") {
+  OptimizationOptions ctx {
+      .prune_unused_functions = true,
+  };
+  PrettyPrintOpts pretty_ctx {};
+  checkPrettyPrintOutput("mutual_recursion.lsl", ctx, pretty_ctx);
+}
+
+TEST_CASE("prune_chain.lsl") {
+  OptimizationOptions ctx {
+      .fold_constants = true,
+      .prune_unused_locals = true,
+      .prune_unused_globals = true,
+      .prune_unused_functions = true,
+  };
+  PrettyPrintOpts pretty_ctx {};
+  checkPrettyPrintOutput("prune_chain.lsl", ctx, pretty_ctx);
+}
+
+TEST_CASE("flow_constants.lsl") {
+  OptimizationOptions ctx {
+      .fold_constants = true,
+      .prune_unused_locals = true,
+      .prune_unused_globals = true,
+      .prune_unused_functions = true,
+      .propagate_constants = true,
+  };
+  PrettyPrintOpts pretty_ctx {};
+  checkPrettyPrintOutput("flow_constants.lsl", ctx, pretty_ctx);
+}
+
+TEST_CASE("dead_code.lsl") {
+  OptimizationOptions ctx {
+      .fold_constants = true,
+      .prune_unused_locals = true,
+      .prune_unused_globals = true,
+      .prune_unused_functions = true,
+      .propagate_constants = true,
+      .prune_dead_code = true,
+  };
+  PrettyPrintOpts pretty_ctx {};
+  checkPrettyPrintOutput("dead_code.lsl", ctx, pretty_ctx);
+}
+
+TEST_CASE("inlining.lsl") {
+  OptimizationOptions ctx {
+      .fold_constants = true,
+      .prune_unused_locals = true,
+      .prune_unused_globals = true,
+      .prune_unused_functions = true,
+      .inline_functions = true,
+  };
+  PrettyPrintOpts pretty_ctx {};
+  checkPrettyPrintOutput("inlining.lsl", ctx, pretty_ctx);
+}
+
+TEST_CASE("cse.lsl") {
+  OptimizationOptions ctx {
+      .fold_constants = true,
+      .prune_unused_locals = true,
+      .prune_unused_globals = true,
+      .prune_unused_functions = true,
+      .eliminate_common_subexprs = true,
+  };
+  PrettyPrintOpts pretty_ctx {};
+  checkPrettyPrintOutput("cse.lsl", ctx, pretty_ctx);
+}
+
+TEST_CASE("licm.lsl") {
+  OptimizationOptions ctx {
+      .fold_constants = true,
+      .prune_unused_locals = true,
+      .prune_unused_globals = true,
+      .prune_unused_functions = true,
+      .hoist_loop_invariants = true,
+  };
+  PrettyPrintOpts pretty_ctx {};
+  checkPrettyPrintOutput("licm.lsl", ctx, pretty_ctx);
+}
+
+TEST_CASE("licm_copies.lsl") {
+  OptimizationOptions ctx {
+      .fold_constants = true,
+      .prune_unused_locals = true,
+      .prune_unused_globals = true,
+      .prune_unused_functions = true,
+      .eliminate_common_subexprs = true,
+      .hoist_loop_invariants = true,
+      .prune_dead_stores = true,
+      .propagate_copies = true,
+  };
+  PrettyPrintOpts pretty_ctx {};
+  checkPrettyPrintOutput("licm_copies.lsl", ctx, pretty_ctx);
+}
+
+TEST_CASE("builtin_folding.lsl") {
+  OptimizationOptions ctx {
+      .fold_constants = true,
+      .prune_unused_locals = true,
+      .prune_unused_globals = true,
+      .prune_unused_functions = true,
+      .may_create_new_strs = true,
+  };
+  PrettyPrintOpts pretty_ctx {};
+  checkPrettyPrintOutput("builtin_folding.lsl", ctx, pretty_ctx);
+}
+
+TEST_CASE("dead_stores.lsl") {
+  OptimizationOptions ctx {
+      .fold_constants = true,
+      .prune_unused_locals = true,
+      .prune_unused_globals = true,
+      .prune_unused_functions = true,
+      .prune_dead_stores = true,
+  };
+  PrettyPrintOpts pretty_ctx {};
+  checkPrettyPrintOutput("dead_stores.lsl", ctx, pretty_ctx);
+}
+
+TEST_CASE("copy_propagation.lsl") {
+  OptimizationOptions ctx {
+      .fold_constants = true,
+      .prune_unused_locals = true,
+      .prune_unused_globals = true,
+      .prune_unused_functions = true,
+      .propagate_copies = true,
+  };
+  PrettyPrintOpts pretty_ctx {};
+  checkPrettyPrintOutput("copy_propagation.lsl", ctx, pretty_ctx);
+}
+
 TEST_CASE("scope3.lsl") {
   OptimizationOptions ctx {
       .fold_constants = true,
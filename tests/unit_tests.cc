@@ -1,7 +1,12 @@
 #include "tailslide.hh"
 #include "doctest.hh"
 #include "bitstream.hh"
+#include "control_flow.hh"
 #include "operations.hh"
+#include "name_suggestions.hh"
+#include "diagnostics.hh"
+#include "profiler.hh"
+#include "testutils.hh"
 
 #include <cmath>
 #include <limits>
@@ -195,4 +200,470 @@ TEST_CASE("Float to int cast boundary conditions") {
   }
 }
 
+TEST_CASE("Name suggestions") {
+  ScriptAllocator allocator;
+  ScriptContext context {
+    nullptr,
+    &allocator
+  };
+  allocator.setContext(&context);
+
+  auto *table = allocator.newTracked<LSLSymbolTable>(SYMTAB_GLOBAL);
+  for (const char *name : {"llSay", "llOwnerSay", "llRegionSay", "llShout", "llWhisper", "llList2String"}) {
+    table->define(allocator.newTracked<LSLSymbol>(
+        name, LSLType::get(LST_NULL), SYM_FUNCTION, SYM_BUILTIN
+    ));
+  }
+  table->define(allocator.newTracked<LSLSymbol>(
+      "llOwnerSey", LSLType::get(LST_INTEGER), SYM_VARIABLE, SYM_GLOBAL
+  ));
+
+  NameSuggestion suggestion;
+  CHECK(table->suggest("llOwnerSya", SYM_FUNCTION, 2, suggestion));
+  CHECK_EQ(std::string(suggestion.symbol->getName()), "llOwnerSay");
+
+  // case-only differences are the best possible match
+  suggestion = {};
+  CHECK(table->suggest("LLsay", SYM_FUNCTION, 1, suggestion));
+  CHECK_EQ(std::string(suggestion.symbol->getName()), "llSay");
+
+  // only symbols of the right type get suggested
+  suggestion = {};
+  CHECK(table->suggest("llOwnerSey", SYM_FUNCTION, 2, suggestion));
+  CHECK_EQ(std::string(suggestion.symbol->getName()), "llOwnerSay");
+
+  // symbols added after the index was built are picked up
+  table->define(allocator.newTracked<LSLSymbol>(
+      "llOwnerSays", LSLType::get(LST_NULL), SYM_FUNCTION, SYM_BUILTIN
+  ));
+  suggestion = {};
+  CHECK(table->suggest("llOwnerSaysz", SYM_FUNCTION, 2, suggestion));
+  CHECK_EQ(std::string(suggestion.symbol->getName()), "llOwnerSays");
+
+  suggestion = {};
+  CHECK_FALSE(table->suggest("llFooBarBaz", SYM_FUNCTION, 2, suggestion));
+  CHECK_EQ(suggestion.symbol, nullptr);
+}
+
+TEST_CASE("Builtins profiles") {
+  auto *default_builtins = tailslide_get_builtins_profile("default");
+  REQUIRE_NE(default_builtins, nullptr);
+
+  const char *profile_file = "builtins_profile_test.txt";
+  FILE *fp = fopen(profile_file, "w");
+  REQUIRE_NE(fp, nullptr);
+  fputs("integer llAbs( integer val ) pure\n", fp);
+  fputs("integer osIsNpc( key npc )\n", fp);
+  fputs("const float PI = 3.14159265\n", fp);
+  fputs("event state_entry(  )\n", fp);
+  fclose(fp);
+  auto *os_builtins = tailslide_add_builtins_profile("os_test", profile_file);
+  remove(profile_file);
+
+  CHECK_EQ(tailslide_get_builtins_profile("os_test"), os_builtins);
+  CHECK_EQ(os_builtins->lookup("llSay"), nullptr);
+  CHECK_NE(os_builtins->lookup("osIsNpc"), nullptr);
+  // identical builtins share the same symbol
+  CHECK_EQ(os_builtins->lookup("llAbs"), default_builtins->lookup("llAbs"));
+  CHECK_EQ(os_builtins->lookup("PI"), default_builtins->lookup("PI"));
+  // functions without attributes are assumed to do anything
+  auto *npc_sym = os_builtins->lookup("osIsNpc");
+  CHECK(npc_sym->hasBuiltinAttr(BUILTIN_ATTR_WRITES_WORLD));
+  CHECK_FALSE(npc_sym->hasBuiltinAttr(BUILTIN_ATTR_PURE));
+  auto *abs_sym = os_builtins->lookup("llAbs");
+  CHECK(abs_sym->hasBuiltinAttr(BUILTIN_ATTR_PURE));
+  CHECK(abs_sym->hasBuiltinAttr(BUILTIN_ATTR_DETERMINISTIC));
+
+  const char *script_src = "default{state_entry(){osIsNpc(NULL_KEY);}}";
+  {
+    ScopedScriptParser parser(os_builtins);
+    parser.parseLSLBytes(script_src, (int)strlen(script_src));
+    parser.script->collectSymbols();
+    parser.script->determineTypes();
+    // NULL_KEY isn't in this profile
+    CHECK_EQ(parser.logger.getErrors(), 1);
+  }
+
+  const char *image_file = "builtins_image_test.bin";
+  REQUIRE(tailslide_save_builtins_image(default_builtins, image_file));
+  auto *image_builtins = tailslide_load_builtins_image("image_test", image_file);
+  remove(image_file);
+  REQUIRE_NE(image_builtins, nullptr);
+  CHECK_EQ(image_builtins->getMap().size(), default_builtins->getMap().size());
+  CHECK_EQ(image_builtins->lookup("llOwnerSay"), default_builtins->lookup("llOwnerSay"));
+  CHECK_EQ(image_builtins->lookup("NULL_KEY"), default_builtins->lookup("NULL_KEY"));
+  CHECK_EQ(image_builtins->lookup("ZERO_ROTATION"), default_builtins->lookup("ZERO_ROTATION"));
+  CHECK_EQ(image_builtins->lookup("llSleep")->getBuiltinAttrs(), default_builtins->lookup("llSleep")->getBuiltinAttrs());
+
+  // an image with a bad type on its last entry gets rejected as a whole
+  REQUIRE(tailslide_save_builtins_image(default_builtins, image_file));
+  FILE *image_fp = fopen(image_file, "r+b");
+  REQUIRE_NE(image_fp, nullptr);
+  uint8_t num_entries_bytes[4];
+  fseek(image_fp, 8, SEEK_SET);
+  REQUIRE_EQ(fread(num_entries_bytes, 1, 4, image_fp), 4);
+  uint32_t num_entries = num_entries_bytes[0] | (num_entries_bytes[1] << 8) | (num_entries_bytes[2] << 16)
+      | ((uint32_t)num_entries_bytes[3] << 24);
+  // header, then the last entry's name offset and kind come before its type
+  fseek(image_fp, 20 + (long)(num_entries - 1) * 28 + 5, SEEK_SET);
+  fputc(0xFF, image_fp);
+  fclose(image_fp);
+  CHECK_EQ(tailslide_load_builtins_image("bad_image_test", image_file), nullptr);
+  CHECK_EQ(tailslide_get_builtins_profile("bad_image_test"), nullptr);
+  remove(image_file);
+}
+
+TEST_CASE("Operator result types") {
+  CHECK_EQ(TYPE(LST_INTEGER)->getResultType(OP_PLUS, TYPE(LST_FLOATINGPOINT)), TYPE(LST_FLOATINGPOINT));
+  CHECK_EQ(TYPE(LST_VECTOR)->getResultType(OP_MUL, TYPE(LST_VECTOR)), TYPE(LST_FLOATINGPOINT));
+  CHECK_EQ(TYPE(LST_STRING)->getResultType(OP_NEQ, TYPE(LST_KEY)), TYPE(LST_INTEGER));
+  CHECK_EQ(TYPE(LST_KEY)->getResultType(OP_PLUS, TYPE(LST_STRING)), nullptr);
+  // list + anything but void
+  CHECK_EQ(TYPE(LST_VECTOR)->getResultType(OP_PLUS, TYPE(LST_LIST)), TYPE(LST_LIST));
+  CHECK_EQ(TYPE(LST_LIST)->getResultType(OP_PLUS, TYPE(LST_NULL)), nullptr);
+  // unary
+  CHECK_EQ(TYPE(LST_QUATERNION)->getResultType(OP_MINUS, nullptr), TYPE(LST_QUATERNION));
+  CHECK_EQ(TYPE(LST_FLOATINGPOINT)->getResultType(OP_BIT_NOT, nullptr), nullptr);
+  // compound assignment
+  CHECK_EQ(TYPE(LST_FLOATINGPOINT)->getResultType(OP_ADD_ASSIGN, TYPE(LST_INTEGER)), TYPE(LST_FLOATINGPOINT));
+  CHECK_EQ(TYPE(LST_INTEGER)->getResultType(OP_ADD_ASSIGN, TYPE(LST_FLOATINGPOINT)), nullptr);
+  CHECK_EQ(TYPE(LST_INTEGER)->getResultType(OP_MUL_ASSIGN, TYPE(LST_FLOATINGPOINT)), TYPE(LST_FLOATINGPOINT));
+  CHECK_EQ(TYPE(LST_ERROR)->getResultType(OP_MINUS, TYPE(LST_LIST)), TYPE(LST_ERROR));
+
+  CHECK(TYPE(LST_INTEGER)->canCoerce(TYPE(LST_FLOATINGPOINT)));
+  CHECK_FALSE(TYPE(LST_FLOATINGPOINT)->canCoerce(TYPE(LST_INTEGER)));
+  CHECK(TYPE(LST_KEY)->canCoerce(TYPE(LST_STRING)));
+  CHECK(TYPE(LST_LIST)->canCoerce(TYPE(LST_ERROR)));
+  CHECK_FALSE(TYPE(LST_LIST)->canCoerce(TYPE(LST_STRING)));
+}
+
+TEST_CASE("Call graph SCCs") {
+  ScriptAllocator allocator;
+  ScriptContext context {
+    nullptr,
+    &allocator
+  };
+  allocator.setContext(&context);
+
+  auto make_func = [&](const char *name) {
+    return allocator.newTracked<LSLSymbol>(name, LSLType::get(LST_NULL), SYM_FUNCTION, SYM_GLOBAL);
+  };
+  auto *a = make_func("a"), *b = make_func("b"), *c = make_func("c"), *d = make_func("d"), *e = make_func("e");
+
+  CallGraph graph;
+  for (auto *func : {a, b, c, d, e})
+    graph.addFunction(func);
+  // a <-> b, a -> c, d -> d, e unreferenced. only a is called from an event.
+  graph.addCall(nullptr, a);
+  graph.addCall(a, b);
+  graph.addCall(b, a);
+  graph.addCall(a, c);
+  graph.addCall(a, c);
+  graph.addCall(d, d);
+  graph.finalize();
+
+  CHECK(graph.isReachable(a));
+  CHECK(graph.isReachable(b));
+  CHECK(graph.isReachable(c));
+  CHECK_FALSE(graph.isReachable(d));
+  CHECK_FALSE(graph.isReachable(e));
+
+  CHECK(graph.isRecursive(a));
+  CHECK(graph.isRecursive(d));
+  CHECK_FALSE(graph.isRecursive(c));
+  CHECK_EQ(graph.getSCCIndex(a), graph.getSCCIndex(b));
+  CHECK_NE(graph.getSCCIndex(a), graph.getSCCIndex(c));
+  // callees come before callers
+  CHECK_LT(graph.getSCCIndex(c), graph.getSCCIndex(a));
+  CHECK_EQ(graph.getCallees(a).size(), 2);
+  CHECK_EQ(graph.getSCCs().size(), 4);
+}
+
+TEST_CASE("Lazy log message formatting") {
+  ScriptAllocator allocator;
+  Logger logger(&allocator);
+  ScriptContext context {
+    nullptr,
+    &allocator,
+    &logger
+  };
+  allocator.setContext(&context);
+
+  TailslideLType loc {3, 5, 3, 10};
+  {
+    // string arguments have to outlive the temporaries they were passed as
+    std::string member_name("foo");
+    logger.error(&loc, E_MEMBER_NOT_VARIABLE, member_name.c_str(), "x", "function");
+    member_name = "bar";
+  }
+  logger.error(&loc, E_DUPLICATE_DECLARATION, "foo", 1, 2);
+  CHECK_EQ(logger.getErrors(), 2);
+
+  auto &messages = logger.getMessages();
+  REQUIRE_EQ(messages.size(), 2);
+  CHECK_EQ(messages[0]->getError(), E_MEMBER_NOT_VARIABLE);
+  REQUIRE_EQ(messages[0]->getNumArgs(), 3);
+  CHECK(messages[0]->getArg(0).is_string);
+  // the same string gets interned once
+  CHECK_EQ(messages[0]->getArg(0).str_val, messages[1]->getArg(0).str_val);
+  CHECK_FALSE(messages[1]->getArg(1).is_string);
+  CHECK_EQ(messages[1]->getArg(2).int_val, 2);
+
+  CHECK_EQ(messages[0]->getMessage(), "Trying to access `foo.x', but `foo' is a function");
+  CHECK_EQ(messages[1]->getMessage(), "Duplicate declaration of `foo'; previously declared at (1, 2).");
+}
+
+TEST_CASE("Streaming diagnostic sinks") {
+  class CollectingSink : public DiagnosticSink {
+    public:
+      void emit(LogMessage *message) override {
+        mLines.push_back(message->toString());
+      }
+      std::vector<std::string> mLines;
+  };
+
+  ScriptAllocator allocator;
+  Logger logger(&allocator);
+  ScriptContext context {
+    nullptr,
+    &allocator,
+    &logger
+  };
+  allocator.setContext(&context);
+
+  CollectingSink sink;
+  logger.setSink(&sink);
+  logger.setRetainMessages(false);
+  TailslideLType loc {4, 1, 4, 8};
+  logger.error(&loc, E_UNDECLARED, "foo");
+  logger.error(&loc, W_EMPTY_IF);
+
+  // streamed in the order they were logged, but not kept around
+  REQUIRE_EQ(sink.mLines.size(), 2);
+  CHECK_EQ(sink.mLines[0], "ERROR:: (  4,  1): [E10006] `foo' is undeclared.");
+  CHECK_EQ(logger.getMessages().size(), 0);
+  CHECK_EQ(logger.getErrors(), 1);
+  CHECK_EQ(logger.getWarnings(), 1);
+
+  std::string json;
+  append_json_string(json, "a\"b\\c\n\x01");
+  CHECK_EQ(json, "\"a\\\"b\\\\c\\n\\u0001\"");
+}
+
+TEST_CASE("Diagnostic budget") {
+  static const char *NOISY_SCRIPT = "default{state_entry(){a; b; c; d; e; integer unused;}}";
+  ParserRef parser(new ScopedScriptParser(nullptr));
+  DiagnosticBudget budget {};
+  budget.max_errors = 2;
+  budget.code_caps[E_UNDECLARED] = 1;
+  parser->logger.setBudget(budget);
+  auto *script = parser->parseLSLBytes(NOISY_SCRIPT, (int)strlen(NOISY_SCRIPT));
+  REQUIRE_NE(script, nullptr);
+  script->collectSymbols();
+  script->determineTypes();
+  script->checkSymbols();
+
+  CHECK(parser->logger.isOverBudget());
+  // one undeclared error made it through the per-code cap, then the budget error.
+  // checkSymbols() bailed, so nothing about `unused`.
+  auto &messages = parser->logger.getMessages();
+  REQUIRE_EQ(messages.size(), 2);
+  CHECK_EQ(messages[0]->getError(), E_UNDECLARED);
+  CHECK_EQ(messages[1]->getError(), E_DIAGNOSTIC_BUDGET_EXCEEDED);
+  CHECK_EQ(parser->logger.getWarnings(), 0);
+}
+
+TEST_CASE("Warning budget") {
+  static const char *NOISY_SCRIPT = "default{state_entry(){integer a; integer b; integer c;}}";
+  ParserRef parser(new ScopedScriptParser(nullptr));
+  DiagnosticBudget budget {};
+  budget.max_warnings = 1;
+  parser->logger.setBudget(budget);
+  auto *script = parser->parseLSLBytes(NOISY_SCRIPT, (int)strlen(NOISY_SCRIPT));
+  REQUIRE_NE(script, nullptr);
+  script->collectSymbols();
+  script->determineTypes();
+  script->checkSymbols();
+
+  // too many warnings only stops them being reported, it's not an error.
+  CHECK_FALSE(parser->logger.isOverBudget());
+  CHECK_EQ(parser->logger.getErrors(), 0);
+  CHECK_EQ(parser->logger.getWarnings(), 3);
+  auto &messages = parser->logger.getMessages();
+  REQUIRE_EQ(messages.size(), 2);
+  // the notice goes wherever the dropped warning would have, so don't care about order.
+  CHECK_NE(messages[0]->getError(), messages[1]->getError());
+  for (auto *message : messages) {
+    CHECK_EQ(message->getType(), LOG_WARN);
+    CHECK((message->getError() == W_DECLARED_BUT_NOT_USED || message->getError() == W_WARNING_BUDGET_EXCEEDED));
+  }
+}
+
+TEST_CASE("Pass profiler") {
+  static const char *PROFILED_SCRIPT = "default{state_entry(){llOwnerSay((string)(1 + 2));}}";
+  PassProfiler profiler;
+  ParserRef parser(new ScopedScriptParser(nullptr));
+  parser->context.profiler = &profiler;
+  auto *script = parser->parseLSLBytes(PROFILED_SCRIPT, (int)strlen(PROFILED_SCRIPT));
+  REQUIRE_NE(script, nullptr);
+  script->collectSymbols();
+  script->determineTypes();
+  script->determineTypes();
+
+  auto &profiles = profiler.getProfiles();
+  REQUIRE_EQ(profiles.size(), 3);
+  CHECK_EQ(std::string(profiles[0].name), "parse");
+  CHECK_GT(profiles[0].alloc_objects, 0);
+  CHECK_EQ(std::string(profiles[2].name), "determine_types");
+  CHECK_EQ(profiles[2].runs, 2);
+#ifdef TAILSLIDE_PROFILE_COUNTERS
+  CHECK_GT(profiles[2].node_visits, 0);
+#else
+  CHECK_EQ(profiles[2].node_visits, 0);
+#endif
+
+  std::string json;
+  profiler.writeJSON(json);
+  CHECK_NE(json.find("\"name\":\"collect_symbols\""), std::string::npos);
+}
+
+TEST_CASE("Counts-only logging") {
+  static const char *NOISY_SCRIPT = "default{state_entry(){a; b; integer unused;}}";
+  ParserRef parser(new ScopedScriptParser(nullptr));
+  parser->logger.setCountsOnly(true);
+  auto *script = parser->parseLSLBytes(NOISY_SCRIPT, (int)strlen(NOISY_SCRIPT));
+  REQUIRE_NE(script, nullptr);
+  script->collectSymbols();
+  script->determineTypes();
+  script->checkSymbols();
+
+  CHECK_EQ(parser->logger.getMessages().size(), 0);
+  CHECK_EQ(parser->logger.getCodeCount(E_UNDECLARED), 2);
+  CHECK_EQ(parser->logger.getCodeCount(W_DECLARED_BUT_NOT_USED), 1);
+  CHECK_EQ(parser->logger.getCodeCount(E_SYNTAX_ERROR), 0);
+  CHECK_EQ(parser->logger.getErrors(), 2);
+}
+
+static int count_uses(LSLSymbol *sym) {
+  int uses = 0;
+  for (auto *id = sym->getFirstUse(); id; id = id->getNextUse()) {
+    CHECK_EQ(id->getSymbol(), sym);
+    ++uses;
+  }
+  return uses;
+}
+
+static int count_defs(LSLSymbol *sym) {
+  int defs = 0;
+  for (auto *expr = sym->getFirstDef(); expr; expr = expr->getNextDef())
+    ++defs;
+  return defs;
+}
+
+TEST_CASE("Constant pool") {
+  static const char *FOLDING_SCRIPT = "default{state_entry(){"
+      "llOwnerSay((string)(1 + 2)); llOwnerSay((string)(4 - 1)); llSetPos(<1, 2, 3> * 2.0);"
+  "}}";
+  ParserRef parser(new ScopedScriptParser(nullptr));
+  auto *script = parser->parseLSLBytes(FOLDING_SCRIPT, (int)strlen(FOLDING_SCRIPT));
+  REQUIRE_NE(script, nullptr);
+  script->collectSymbols();
+  script->determineTypes();
+  script->propagateValues();
+
+  // folding the same thing again only finds what's already there
+  size_t pooled = parser->constant_pool.size();
+  size_t allocated = parser->allocator.getAllocatedObjects();
+  script->propagateValues();
+  CHECK_EQ(parser->constant_pool.size(), pooled);
+  CHECK_EQ(parser->allocator.getAllocatedObjects(), allocated);
+
+  auto &pool = parser->constant_pool;
+  CHECK_EQ(pool.getInteger(3), pool.getInteger(3));
+  CHECK(pool.getInteger(3)->isStatic());
+  CHECK_EQ(pool.getInteger(0), TYPE(LST_INTEGER)->getDefaultValue());
+  CHECK_EQ(pool.getString("3"), pool.getString(std::string("3").c_str()));
+  CHECK_NE((LSLConstant *)pool.getString("3"), (LSLConstant *)pool.getKey("3"));
+  CHECK_NE(pool.getFloat(0.0), pool.getFloat(-0.0));
+  CHECK_EQ(pool.getVector(2, 4, 6), pool.intern(parser->allocator.newTracked<LSLVectorConstant>(2, 4, 6)));
+
+  // putting a pooled constant in the tree puts in a copy
+  auto *cv = pool.getInteger(3);
+  auto *const_expr = parser->allocator.newTracked<LSLConstantExpression>(cv);
+  CHECK_NE(const_expr->getConstantValue(), cv);
+  CHECK_EQ(cv->getParent(), nullptr);
+}
+
+TEST_CASE("Symbol use and def lists") {
+  static const char *USE_SCRIPT = "integer g; default{state_entry(){g = 1; g += 2; llOwnerSay((string)g);}}";
+  ParserRef parser(new ScopedScriptParser(nullptr));
+  auto *script = parser->parseLSLBytes(USE_SCRIPT, (int)strlen(USE_SCRIPT));
+  REQUIRE_NE(script, nullptr);
+  script->collectSymbols();
+  script->determineTypes();
+  script->recalculateReferenceData();
+
+  auto *sym = script->lookupSymbol("g", SYM_VARIABLE);
+  REQUIRE_NE(sym, nullptr);
+  // the declaration, both assignments and the read
+  CHECK_EQ(count_uses(sym), 4);
+  CHECK_EQ(sym->getReferences(), 4);
+  CHECK_EQ(count_defs(sym), 2);
+
+  // dropping a def from the tree drops its identifier from the use list too
+  auto *def = sym->getFirstDef();
+  auto *stmt = def->getParent();
+  stmt->getParent()->removeChild(stmt);
+  CHECK_EQ(count_uses(sym), 3);
+  CHECK_EQ(sym->getReferences(), 3);
+  CHECK_EQ(count_defs(sym), 1);
+  CHECK_NE(sym->getFirstDef(), def);
+
+  // recalculating from scratch agrees with the incremental updates
+  script->recalculateReferenceData();
+  CHECK_EQ(count_uses(sym), 3);
+  CHECK_EQ(count_defs(sym), 1);
+}
+
+TEST_CASE("Control flow graph") {
+  static const char *FLOW_SCRIPT = "default{state_entry(){"
+      "integer i = 1; @top; if (i) jump top; else return; llOwnerSay(\"dead\");"
+  "}}";
+  ParserRef parser(new ScopedScriptParser(nullptr));
+  auto *script = parser->parseLSLBytes(FLOW_SCRIPT, (int)strlen(FLOW_SCRIPT));
+  REQUIRE_NE(script, nullptr);
+  script->collectSymbols();
+  script->determineTypes();
+  // whether a jump can fall through depends on how many jumps go to its label
+  script->recalculateReferenceData();
+  auto *handler = script->getStates()->getChild(0)->getChild(1)->getChild(0);
+  REQUIRE_EQ(handler->getNodeType(), NODE_EVENT_HANDLER);
+
+  ControlFlowGraph graph;
+  graph.build(handler);
+  auto &blocks = graph.getBlocks();
+  auto &entry = blocks[ControlFlowGraph::ENTRY_BLOCK];
+  // just the declaration, then straight into the label's block
+  REQUIRE_EQ(entry.nodes.size(), 1);
+  REQUIRE_EQ(entry.succs.size(), 1);
+  auto &label_block = blocks[entry.succs[0]];
+  // the condition, plus the jump back to the label
+  CHECK_EQ(label_block.nodes.size(), 1);
+  CHECK_EQ(label_block.preds.size(), 2);
+
+  // `llOwnerSay()` comes after both branches leave, nothing can reach it.
+  bool found_dead = false;
+  for (uint32_t i = 0; i < blocks.size(); ++i) {
+    for (auto *node : blocks[i].nodes) {
+      if (node->getNodeSubType() == NODE_FUNCTION_EXPRESSION) {
+        found_dead = true;
+        CHECK_FALSE(graph.isReachable(i));
+      }
+    }
+  }
+  CHECK(found_dead);
+  CHECK(graph.isReachable(ControlFlowGraph::EXIT_BLOCK));
+  CHECK_EQ(graph.getReversePostOrder().front(), ControlFlowGraph::ENTRY_BLOCK);
+}
+
 TEST_SUITE_END();